@@ -46,7 +46,8 @@ static void usage(char *name)
 	cout << name << " usage:\n" <<
 	     "\t-f source_file: read ascii assembly code from file\n" <<
 	     "\t-t text_stream_file: [optional] output .text to specified file\n" <<
-	     "\t-d data_stream_file: [optional] output .data to specified file\n";
+	     "\t-d data_stream_file: [optional] output .data to specified file\n" <<
+	     "\t-p profile_file: [optional] hint branches from a profile written by rsim -P\n";
 }
 
 
@@ -58,10 +59,11 @@ int32_t main(int32_t argc, char **argv)
 	int32_t ch;
 	char *source = NULL;
 	char *textdest = NULL, *datadest = NULL;
+	char *profile = NULL;
 	ofstream text_stream;
 	ofstream data_stream;
 
-	while ((ch = getopt(argc, argv, "t:d:f:")) != -1) {
+	while ((ch = getopt(argc, argv, "t:d:f:p:")) != -1) {
 		switch (ch) {
 		case 't':
 			textdest = optarg;
@@ -76,6 +78,10 @@ int32_t main(int32_t argc, char **argv)
 			source = optarg;
 			break;
 
+		case 'p':
+			profile = optarg;
+			break;
+
 		default:
 			usage(*argv);
 			exit(10);
@@ -103,6 +109,10 @@ int32_t main(int32_t argc, char **argv)
 	bool success = false;
 	cgen = new codegen(writeback_position_t(text_segment, &text_stream)
 	                  ,writeback_position_t(data_segment, &data_stream));
+	if (profile && !cgen->load_profile(profile)) {
+		cerr << *argv << ": " << profile << " does not exist" << endl;
+		exit(20);
+	}
 
 	// Perform the lexing and grammar
 	success = 0 == yyparse();
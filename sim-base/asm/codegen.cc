@@ -1,5 +1,7 @@
 #include "codegen.h"
 #include "../sim/types.h"
+#include <fstream>
+#include <stdio.h>
 
 using namespace std;
 
@@ -49,3 +51,32 @@ void codegen::emit_label_address(string name)
 		current->out->write((char *)&container, sizeof(uint32_t));
 	}
 }
+
+
+bool codegen::load_profile(const char *filename)
+{
+	ifstream in(filename);
+	if (!in.is_open()) {
+		return false;
+	}
+
+	string line;
+	getline(in, line); // column headings
+	while (getline(in, line)) {
+		uint32_t pc, executed, taken;
+		if (sscanf(line.c_str(), "%x,%u,%u", &pc, &executed, &taken) == 3 && executed) {
+			profile_hints[pc] = (2 * taken >= executed) ? HINT_TAKEN : HINT_NOT_TAKEN;
+		}
+	}
+	return true;
+}
+
+
+byte codegen::hint_for(uint32_t pc, bool branch, byte hint)
+{
+	if (hint != HINT_NONE || !branch) {
+		return hint;
+	}
+	hints_t::const_iterator i = profile_hints.find(pc);
+	return i == profile_hints.end() ? HINT_NONE : i->second;
+}
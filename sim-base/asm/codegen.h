@@ -21,10 +21,12 @@ struct writeback_position_t {
 class codegen {
 	typedef std::multimap<std::string, writeback_position_t> pending_balance_t;
 	typedef std::map<std::string, writeback_position_t> labels_t;
+	typedef std::map<uint32_t, byte> hints_t;
 	writeback_position_t text, data;
 	const writeback_position_t *current;
 	pending_balance_t pending_balance;
 	labels_t labels;
+	hints_t profile_hints;
 	codegen();
 
 public:
@@ -76,6 +78,20 @@ public:
 	// address will be written at location fileloc into ostream file.
 	void emit_label_address(std::string name);
 
+	// address the next emitted byte will land on in the simulator
+	uint32_t address()
+	{
+		return (uint32_t)(std::streamoff)current->position + (uint32_t)(std::streamoff)current->out->tellp();
+	}
+
+	// read the per-branch CSV written by rsim -P. Branches that were taken at least half
+	// the time get HINT_TAKEN, the rest HINT_NOT_TAKEN. returns false if unreadable.
+	bool load_profile(const char *filename);
+
+	// the padding byte for the instruction that started at pc: an explicit hint wins,
+	// otherwise a branch takes whatever the profile says about it.
+	byte hint_for(uint32_t pc, bool branch, byte hint);
+
 	// When the file is finished, use this method to see if all labels
 	// are "balanced". If not, you should indicate an error and exit from the app
 	// due to a label used but not defined.
@@ -376,8 +376,8 @@ static void yy_fatal_error (yyconst char msg[]  );
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 44
-#define YY_END_OF_BUFFER 45
+#define YY_NUM_RULES 52
+#define YY_END_OF_BUFFER 53
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -385,20 +385,21 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_accept[104] =
+static yyconst flex_int16_t yy_accept[118] =
     {   0,
-        0,    0,    0,    0,   45,   43,    2,    3,    3,    4,
-        1,   42,   36,   43,   23,   40,   40,   38,   38,   27,
-       38,   38,   38,   15,    6,    5,   44,    2,    3,    1,
-        1,   42,   39,   40,   23,   23,   23,   23,   23,   23,
-       23,    0,   38,   37,   38,   38,   38,   38,   31,   32,
-       33,   38,   38,   38,   15,   14,    7,    8,   12,   13,
-        9,   11,   10,   23,   23,   23,   23,   23,   23,   41,
-       25,   38,   29,   30,   35,   38,   38,    7,    8,   23,
-       23,   23,   23,   23,   23,   24,   28,   26,   38,    7,
-       23,   19,   17,   23,   16,   18,   38,   21,   20,   38,
-
-       22,   34,    0
+        0,    0,    0,    0,   53,   51,    2,    3,    3,    4,
+        1,   50,   44,   51,   25,   48,   48,   46,   46,   32,
+       46,   46,   46,   46,   46,   46,   15,    6,    5,   52,
+        2,    3,    1,    1,   50,   47,   48,   25,   25,   25,
+       25,   25,   25,   23,   25,    0,   46,   45,   46,   46,
+       46,   46,   46,   36,   37,   41,   38,   46,   46,   46,
+       39,   46,   40,   46,   15,   14,    7,    8,   12,   13,
+        9,   11,   10,   25,   25,   25,   24,   25,   25,   25,
+       49,   27,   46,   34,   35,   30,   29,   43,   31,   46,
+       46,    7,    8,   25,   25,   25,   25,   25,   25,   26,
+
+       33,   28,   46,    7,   25,   19,   17,   25,   16,   18,
+       46,   21,   20,   46,   22,   42,    0
     } ;
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -414,9 +415,9 @@ static yyconst flex_int32_t yy_ec[256] =
        16,   16,   16,   16,   16,   16,   16,   16,   16,   16,
         1,   17,    1,    1,   18,    1,   19,   20,   21,   22,
 
-       23,   24,   25,   16,   26,   16,   16,   27,   16,   28,
-       29,   30,   31,   32,   33,   34,   35,   16,   36,   37,
-       38,   39,    1,    1,    1,    1,    1,    1,    1,    1,
+       23,   24,   25,   16,   26,   16,   16,   27,   28,   29,
+       30,   31,   32,   33,   34,   35,   36,   37,   38,   39,
+       40,   41,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -433,120 +434,157 @@ static yyconst flex_int32_t yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static yyconst flex_int32_t yy_meta[40] =
+static yyconst flex_int32_t yy_meta[42] =
     {   0,
-        1,    1,    2,    1,    3,    1,    1,    1,    4,    1,
-        5,    5,    5,    6,    5,    7,    3,    7,    5,    5,
-        5,    5,    5,    5,    7,    7,    7,    7,    7,    7,
-        7,    7,    7,    7,    7,    7,    7,    7,    7
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1
     } ;
 
-static yyconst flex_int16_t yy_base[112] =
+static yyconst flex_int16_t yy_base[118] =
     {   0,
-        0,    0,   37,   38,  224,  225,   42,   47,   54,  225,
-        0,   50,  225,   53,   48,   60,   63,  209,   55,   64,
-       74,   66,   69,    0,  225,  225,   97,   99,  109,    0,
-        0,    0,  107,  111,    0,  189,  183,  201,  189,  195,
-      188,    0,  202,  225,   76,   65,  112,  113,  201,  200,
-      199,  100,   71,  114,    0,  225,  121,  126,  225,  225,
-      225,  225,  225,  191,  177,  176,  190,  171,  164,    0,
-       33,  102,  181,  175,  172,  126,   85,  131,  137,  152,
-      145,  148,  145,  131,  142,  149,  148,  147,  132,  142,
-      134,    0,    0,  136,    0,    0,  131,  118,    0,  142,
-
-        0,   72,  225,  169,  176,  180,  183,  186,  193,  200,
-       47
+        1,    2,   42,    3,    4,   84,   83,   86,    5,    6,
+       89,  122,    7,  153,  156,   53,    8,  187,  110,  206,
+      113,  213,  100,  140,  150,  210,  251,    9,   10,  292,
+       11,   12,   13,   14,  225,   15,   16,  315,  170,  194,
+      221,  207,  212,  218,  214,  343,   17,   18,  223,  215,
+      226,  231,  219,   19,   20,   21,   22,  241,  305,  310,
+       23,  319,   24,  306,   25,   26,  330,  334,   27,   28,
+       29,   30,   31,  326,  313,  316,   32,  333,  318,  327,
+       33,  335,  328,   34,   35,   36,   37,   38,   39,  342,
+      338,  359,   40,  346,  350,  355,  354,  341,  356,   41,
+
+       43,   44,  358,   45,  353,   46,   47,  357,   48,   49,
+      360,  340,   50,  361,   51,   52,  389
     } ;
 
-static yyconst flex_int16_t yy_def[112] =
+static yyconst flex_int16_t yy_def[118] =
     {   0,
-      103,    1,  104,  104,  103,  103,  103,  103,  103,  103,
-      105,  106,  103,  103,  107,  103,  103,  108,  108,  108,
-      108,  108,  108,  109,  103,  103,  110,  103,  103,  105,
-      105,  106,  106,  103,  107,  107,  107,  107,  107,  107,
-      107,  111,  108,  103,  108,  108,  108,  108,  108,  108,
-      108,  108,  108,  108,  109,  103,  103,  103,  103,  103,
-      103,  103,  103,  107,  107,  107,  107,  107,  107,  111,
-      108,  108,  108,  108,  108,  108,  108,  103,  103,  107,
-      107,  107,  107,  107,  107,  108,  108,  108,  108,  103,
-      107,  107,  107,  107,  107,  107,  108,  107,  107,  108,
-
-      107,  108,    0,  103,  103,  103,  103,  103,  103,  103,
-      103
+      117,    1,    1,    3,  117,  117,    6,    7,    8,    6,
+        6,    6,    6,    6,    6,   14,   14,    6,   18,   18,
+       18,   18,   18,   18,   18,   18,    6,    6,    6,    1,
+        7,    8,   11,   11,   12,   12,   14,   15,   38,   38,
+       38,   38,   38,   38,   38,    6,   18,    6,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   27,    6,    6,   67,    6,    6,
+        6,    6,    6,   38,   38,   38,   38,   38,   38,   38,
+       46,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   67,   68,   38,   38,   38,   38,   38,   38,   18,
+
+       18,   18,   18,   68,   38,   38,   38,   38,   38,   38,
+       18,   38,   38,   18,   38,   18,    0
     } ;
 
-static yyconst flex_int16_t yy_nxt[265] =
+static yyconst flex_int16_t yy_nxt[431] =
     {   0,
-        6,    7,    8,    9,   10,   11,   12,   13,   14,   15,
-       16,   17,   17,    6,   18,   18,    6,    6,   19,   20,
-       18,   18,   18,   18,   18,   18,   21,   22,   18,   18,
-       18,   18,   23,   18,   18,   18,   18,   18,   18,   25,
-       25,   26,   26,   28,   29,   29,   44,   30,   29,   29,
-       29,   70,   30,   27,   27,   29,   29,   29,   86,   30,
-       33,   33,   33,   34,   34,   34,   36,   37,   44,   38,
-       34,   34,   34,   34,   34,   34,   45,   44,   44,   44,
-       39,   40,   44,   41,   44,   44,   46,   44,   47,   44,
-       76,   48,   49,   50,   52,   72,   42,   71,   44,   51,
-
-       28,   29,   29,   53,   30,   89,   54,   57,   57,   58,
-       29,   29,   29,   44,   30,   44,   59,   33,   33,   33,
-       60,   34,   34,   34,   61,   44,   44,   44,   62,   75,
-       63,   78,   78,   79,   73,   74,   79,   79,   79,   44,
-       87,   90,   90,   79,   44,   44,   77,   79,   79,   79,
-       97,   88,   79,   79,   79,   44,  101,  100,   99,   98,
-       44,   44,   44,   96,   95,   94,   93,   92,  102,   24,
-       24,   24,   24,   24,   24,   24,   31,   91,   31,   31,
-       31,   31,   31,   32,   32,   44,   32,   35,   44,   35,
-       43,   43,   43,   55,   44,   85,   55,   55,   55,   55,
-
-       56,   56,   56,   56,   56,   56,   56,   84,   83,   82,
-       81,   80,   44,   44,   44,   44,   69,   68,   67,   66,
-       65,   64,   44,  103,    5,  103,  103,  103,  103,  103,
-      103,  103,  103,  103,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103
+        5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+       15,   16,   17,   17,    6,   18,   18,    6,    6,   19,
+       20,   18,   21,   18,   18,   18,   18,   22,   23,   24,
+       18,   18,   18,   25,   26,   18,   18,   18,   18,   18,
+       18,   18,   27,   27,   28,   27,   29,   27,   27,   27,
+       27,   27,   27,   27,   27,   27,   27,   27,   30,   27,
+       27,   27,   27,   27,   27,   27,   27,   27,   27,   27,
+       27,   27,   27,   27,   27,   27,   27,   27,   27,   27,
+       27,   27,   27,    5,   31,   32,   32,   32,   33,   34,
+       34,   46,   34,   34,   34,   34,   34,   34,   34,   34,
+
+       34,   34,   34,   34,   34,   34,   34,   34,   34,   34,
+       34,   34,   34,   34,   34,   34,   34,   34,   34,   34,
+       34,   34,   34,   34,   34,   34,   34,   34,   34,   34,
+       35,   49,   36,   36,   36,   58,   35,   35,   53,   35,
+       35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+       35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+       35,   35,   35,   37,   37,   37,   38,   38,   38,   59,
+       38,   38,   60,   38,   39,   40,   38,   41,   38,   38,
+       38,   38,   38,   38,   42,   38,   38,   38,   38,   43,
+       44,   38,   38,   45,   38,   38,   38,   47,   47,   47,
+
+       48,   47,   47,   74,   47,   47,   47,   47,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   50,   61,
+       51,   54,   55,   75,   52,   35,   35,   35,   56,   76,
+       79,   77,   78,   80,   82,   62,   83,   63,   84,   64,
+       57,   65,   65,   85,   65,   86,   65,   65,   65,   65,
+       65,   65,   65,   65,   65,   65,   65,   87,   65,   65,
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   65,   66,   66,   66,   66,   66,   66,   66,   66,
+
+       66,   66,   67,   67,   68,   66,   66,   66,   66,   66,
+       66,   69,   66,   66,   66,   70,   66,   66,   66,   66,
+       71,   66,   66,   66,   72,   66,   73,   66,   66,   66,
+       66,   66,   66,   38,   38,   88,   38,   89,   90,   91,
+       92,   92,   93,   38,   93,   93,   94,   95,   38,   38,
+       96,   97,   38,   81,   81,   81,   98,   81,  103,   99,
+      100,   81,   81,   81,   81,   81,   81,  102,  101,  104,
+      104,  105,  106,  107,  108,  109,  111,  110,  112,  113,
+      115,    0,    0,    0,    0,    0,  114,  116,  117,  117,
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117,
+
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117,
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117,
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117
     } ;
 
-static yyconst flex_int16_t yy_chk[265] =
+static yyconst flex_int16_t yy_chk[431] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    3,
-        4,    3,    4,    7,    7,    7,   71,    7,    8,    8,
-        8,  111,    8,    3,    4,    9,    9,    9,   71,    9,
-       12,   12,   12,   14,   14,   14,   15,   15,   19,   15,
-       16,   16,   16,   17,   17,   17,   19,   20,   46,   22,
-       15,   15,   23,   15,   53,  102,   20,   21,   20,   45,
-       53,   20,   21,   21,   22,   46,   16,   45,   77,   21,
-
-       28,   28,   28,   23,   28,   77,   23,   27,   27,   27,
-       29,   29,   29,   52,   29,   72,   27,   33,   33,   33,
-       27,   34,   34,   34,   27,   47,   48,   54,   27,   52,
-       27,   57,   57,   57,   47,   48,   58,   58,   58,   76,
-       72,   78,   78,   78,   97,   89,   54,   79,   79,   79,
-       89,   76,   90,   90,   90,  100,   98,   97,   94,   91,
-       88,   87,   86,   85,   84,   83,   82,   81,  100,  104,
-      104,  104,  104,  104,  104,  104,  105,   80,  105,  105,
-      105,  105,  105,  106,  106,   75,  106,  107,   74,  107,
-      108,  108,  108,  109,   73,   69,  109,  109,  109,  109,
-
-      110,  110,  110,  110,  110,  110,  110,   68,   67,   66,
-       65,   64,   51,   50,   49,   43,   41,   40,   39,   38,
-       37,   36,   18,    5,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103,  103,  103,  103,  103,  103,  103,
-      103,  103,  103,  103
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    6,    7,    7,    7,    8,    7,   11,
+       11,   16,   11,   11,   11,   11,   11,   11,   11,   11,
+
+       11,   11,   11,   11,   11,   11,   11,   11,   11,   11,
+       11,   11,   11,   11,   11,   11,   11,   11,   11,   11,
+       11,   11,   11,   11,   11,   11,   11,   11,   11,   11,
+       12,   19,   12,   12,   12,   23,   12,   12,   21,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   14,   14,   14,   15,   15,   15,   24,
+       15,   15,   25,   15,   15,   15,   15,   15,   15,   15,
+       15,   15,   15,   15,   15,   15,   15,   15,   15,   15,
+       15,   15,   15,   15,   15,   15,   15,   18,   18,   18,
+
+       18,   18,   18,   39,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   20,   26,
+       20,   22,   22,   40,   20,   35,   35,   35,   22,   41,
+       44,   42,   43,   45,   49,   26,   50,   26,   51,   26,
+       22,   27,   27,   52,   27,   53,   27,   27,   27,   27,
+       27,   27,   27,   27,   27,   27,   27,   58,   27,   27,
+       27,   27,   27,   27,   27,   27,   27,   27,   27,   27,
+       27,   27,   27,   27,   27,   27,   27,   27,   27,   27,
+       27,   27,   30,   30,   30,   30,   30,   30,   30,   30,
+
+       30,   30,   30,   30,   30,   30,   30,   30,   30,   30,
+       30,   30,   30,   30,   30,   30,   30,   30,   30,   30,
+       30,   30,   30,   30,   30,   30,   30,   30,   30,   30,
+       30,   30,   30,   38,   38,   59,   38,   60,   62,   64,
+       67,   67,   67,   38,   68,   68,   74,   75,   38,   38,
+       76,   78,   38,   46,   46,   46,   79,   46,   91,   80,
+       82,   46,   46,   46,   46,   46,   46,   90,   83,   92,
+       92,   94,   95,   96,   97,   98,  103,   99,  105,  108,
+      112,    0,    0,    0,    0,    0,  111,  114,  117,  117,
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117,
+
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117,
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117,
+      117,  117,  117,  117,  117,  117,  117,  117,  117,  117
     } ;
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[45] =
+static yyconst flex_int32_t yy_rule_can_match_eol[53] =
     {   0,
 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-    0, 0, 0, 0, 0,     };
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,     };
 
 static yy_state_type yy_last_accepting_state;
 static char *yy_last_accepting_cpos;
@@ -578,7 +616,7 @@ char *string_buf_ptr;
 extern int32_t yylineno;
 
 
-#line 582 "lex.yy.c"
+#line 620 "lex.yy.c"
 
 #define INITIAL 0
 #define string 1
@@ -762,7 +800,7 @@ YY_DECL
 #line 28 "asm/scanner.lex"
 
 
-#line 766 "lex.yy.c"
+#line 804 "lex.yy.c"
 
 	if ( !(yy_init) )
 		{
@@ -815,13 +853,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 104 )
+				if ( yy_current_state >= 118 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 225 );
+		while ( yy_base[yy_current_state] != 389 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1007,76 +1045,116 @@ YY_RULE_SETUP
 case 23:
 YY_RULE_SETUP
 #line 92 "asm/scanner.lex"
-{return SECTION_IDENT; /*for error reporting*/}
+{return HINT_TAKEN_SUFFIX;     /* static hints: bne.t, bge.nt, ... */}
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 95 "asm/scanner.lex"
-{return ADDI;      }
+#line 93 "asm/scanner.lex"
+{return HINT_NOT_TAKEN_SUFFIX; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 96 "asm/scanner.lex"
-{return ADD;       }
+#line 94 "asm/scanner.lex"
+{return SECTION_IDENT; /*for error reporting*/}
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
 #line 97 "asm/scanner.lex"
-{return SUBI;      }
+{return ADDI;      }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
 #line 98 "asm/scanner.lex"
-{return BRANCH;    }
+{return ADD;       }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
 #line 99 "asm/scanner.lex"
-{return BRANCHEQZ; }
+{return SUBI;      }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
 #line 100 "asm/scanner.lex"
-{return BRANCHGE;  }
+{return MUL;       }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
 #line 101 "asm/scanner.lex"
-{return BRANCHNE;  }
+{return DIV;       }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
 #line 102 "asm/scanner.lex"
-{return LOADADDR;  }
+{return REM;       }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
 #line 103 "asm/scanner.lex"
-{return LOADBYTE;  }
+{return BRANCH;    }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
 #line 104 "asm/scanner.lex"
-{return LOADIMMED; }
+{return BRANCHEQZ; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
 #line 105 "asm/scanner.lex"
-{return SYSCALL;   }
+{return BRANCHGE;  }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
 #line 106 "asm/scanner.lex"
-{return NOOP;      }
+{return BRANCHNE;  }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 109 "asm/scanner.lex"
-{ return *yytext; /* punctuation marks */}
+#line 107 "asm/scanner.lex"
+{return LOADADDR;  }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
+#line 108 "asm/scanner.lex"
+{return LOADBYTE;  }
+	YY_BREAK
+case 38:
+YY_RULE_SETUP
+#line 109 "asm/scanner.lex"
+{return LOADWORD;  }
+	YY_BREAK
+case 39:
+YY_RULE_SETUP
+#line 110 "asm/scanner.lex"
+{return STOREBYTE; }
+	YY_BREAK
+case 40:
+YY_RULE_SETUP
 #line 111 "asm/scanner.lex"
+{return STOREWORD; }
+	YY_BREAK
+case 41:
+YY_RULE_SETUP
+#line 112 "asm/scanner.lex"
+{return LOADIMMED; }
+	YY_BREAK
+case 42:
+YY_RULE_SETUP
+#line 113 "asm/scanner.lex"
+{return SYSCALL;   }
+	YY_BREAK
+case 43:
+YY_RULE_SETUP
+#line 114 "asm/scanner.lex"
+{return NOOP;      }
+	YY_BREAK
+case 44:
+YY_RULE_SETUP
+#line 117 "asm/scanner.lex"
+{ return *yytext; /* punctuation marks */}
+	YY_BREAK
+case 45:
+YY_RULE_SETUP
+#line 119 "asm/scanner.lex"
 {
   // Found a label decl.
   int32_t sl = strlen(yytext);
@@ -1086,9 +1164,9 @@ YY_RULE_SETUP
   return LABELDECL;
 }
 	YY_BREAK
-case 38:
+case 46:
 YY_RULE_SETUP
-#line 120 "asm/scanner.lex"
+#line 128 "asm/scanner.lex"
 {
   // Found a label ref. 
   int32_t sl = strlen(yytext);
@@ -1097,9 +1175,9 @@ YY_RULE_SETUP
   return LABELREF;
 }
 	YY_BREAK
-case 39:
+case 47:
 YY_RULE_SETUP
-#line 128 "asm/scanner.lex"
+#line 136 "asm/scanner.lex"
 {
   // found a register reference
   yylval.sysword = strtol(yytext+1, NULL, 10);
@@ -1110,45 +1188,45 @@ YY_RULE_SETUP
   return REGISTER;
 }
 	YY_BREAK
-case 40:
+case 48:
 YY_RULE_SETUP
-#line 138 "asm/scanner.lex"
+#line 146 "asm/scanner.lex"
 {
   // found an integer
   yylval.sysword = strtol(yytext, NULL, 10);
   return INTEGER;
 }
 	YY_BREAK
-case 41:
+case 49:
 YY_RULE_SETUP
-#line 144 "asm/scanner.lex"
+#line 152 "asm/scanner.lex"
 {
   // found an integer
   yylval.sysword = strtol(yytext, NULL, 16);
   return INTEGER;
 }
 	YY_BREAK
-case 42:
+case 50:
 YY_RULE_SETUP
-#line 150 "asm/scanner.lex"
+#line 158 "asm/scanner.lex"
 {
   return INVALID_REGISTER;
 }
 	YY_BREAK
-case 43:
+case 51:
 YY_RULE_SETUP
-#line 154 "asm/scanner.lex"
+#line 162 "asm/scanner.lex"
 {
   cerr << "invalid character; line " << yylineno << endl;
   exit(10);
 }
 	YY_BREAK
-case 44:
+case 52:
 YY_RULE_SETUP
-#line 159 "asm/scanner.lex"
+#line 167 "asm/scanner.lex"
 ECHO;
 	YY_BREAK
-#line 1152 "lex.yy.c"
+#line 1230 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(string):
 	yyterminate();
@@ -1441,7 +1519,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 104 )
+			if ( yy_current_state >= 118 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1469,11 +1547,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 104 )
+		if ( yy_current_state >= 118 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 103);
+	yy_is_jam = (yy_current_state == 117);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2114,27 +2192,28 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 159 "asm/scanner.lex"
+#line 167 "asm/scanner.lex"
 
 
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -2145,13 +2224,17 @@ void yyfree (void * ptr )
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_RASM_TAB_HPP_INCLUDED
 # define YY_YY_RASM_TAB_HPP_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 1
 #endif
@@ -2159,64 +2242,62 @@ void yyfree (void * ptr )
 extern int yydebug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NEWLINE = 258,
-     TEXT_SECTION = 259,
-     DATA_SECTION = 260,
-     LABELDECL = 261,
-     INTEGER = 262,
-     LABELREF = 263,
-     REGISTER = 264,
-     INVALID_REGISTER = 265,
-     ADDI = 266,
-     ADD = 267,
-     SUBI = 268,
-     BRANCH = 269,
-     BRANCHEQZ = 270,
-     BRANCHGE = 271,
-     BRANCHNE = 272,
-     LOADADDR = 273,
-     LOADBYTE = 274,
-     LOADIMMED = 275,
-     SYSCALL = 276,
-     NOOP = 277,
-     WORD = 278,
-     BYTE = 279,
-     SPACE = 280,
-     ASCII = 281,
-     ASCIIZ = 282,
-     STRING = 283,
-     SECTION_IDENT = 284
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NEWLINE = 258,                 /* NEWLINE  */
+    TEXT_SECTION = 259,            /* TEXT_SECTION  */
+    DATA_SECTION = 260,            /* DATA_SECTION  */
+    LABELDECL = 261,               /* LABELDECL  */
+    INTEGER = 262,                 /* INTEGER  */
+    LABELREF = 263,                /* LABELREF  */
+    REGISTER = 264,                /* REGISTER  */
+    INVALID_REGISTER = 265,        /* INVALID_REGISTER  */
+    ADDI = 266,                    /* ADDI  */
+    ADD = 267,                     /* ADD  */
+    SUBI = 268,                    /* SUBI  */
+    BRANCH = 269,                  /* BRANCH  */
+    BRANCHEQZ = 270,               /* BRANCHEQZ  */
+    BRANCHGE = 271,                /* BRANCHGE  */
+    BRANCHNE = 272,                /* BRANCHNE  */
+    LOADADDR = 273,                /* LOADADDR  */
+    LOADBYTE = 274,                /* LOADBYTE  */
+    LOADIMMED = 275,               /* LOADIMMED  */
+    SYSCALL = 276,                 /* SYSCALL  */
+    NOOP = 277,                    /* NOOP  */
+    WORD = 278,                    /* WORD  */
+    BYTE = 279,                    /* BYTE  */
+    SPACE = 280,                   /* SPACE  */
+    ASCII = 281,                   /* ASCII  */
+    ASCIIZ = 282,                  /* ASCIIZ  */
+    STRING = 283,                  /* STRING  */
+    SECTION_IDENT = 284,           /* SECTION_IDENT  */
+    HINT_TAKEN_SUFFIX = 285,       /* HINT_TAKEN_SUFFIX  */
+    HINT_NOT_TAKEN_SUFFIX = 286,   /* HINT_NOT_TAKEN_SUFFIX  */
+    MUL = 287,                     /* MUL  */
+    DIV = 288,                     /* DIV  */
+    REM = 289,                     /* REM  */
+    LOADWORD = 290,                /* LOADWORD  */
+    STOREBYTE = 291,               /* STOREBYTE  */
+    STOREWORD = 292                /* STOREWORD  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
+/* Value type.  */
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
 extern YYSTYPE yylval;
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
 int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_YY_RASM_TAB_HPP_INCLUDED  */
 
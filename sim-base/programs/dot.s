@@ -0,0 +1,39 @@
+.text
+
+main:
+	la $6, xs
+	la $7, ys
+	li $1, 0
+	li $5, 6
+
+loop:
+	lb  $8, 0($6)
+	lb  $9, 0($7)
+	mul $10, $8, $9
+	add $1, $1, $10
+	addi $6, $6, 1
+	addi $7, $7, 1
+	subi $5, $5, 1
+	bge.t $5, $0, loop
+
+	li $3, 10
+	div $11, $1, $3
+	rem $12, $1, $3
+
+	add $4, $0, $1
+	li $2, 1
+	syscall
+	add $4, $0, $11
+	syscall
+	add $4, $0, $12
+	syscall
+
+	li $2, 10
+	syscall
+
+.data
+
+xs:
+	.byte 1 2 3 4 5 6 7
+ys:
+	.byte 7 6 5 4 3 2 1
@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.7"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,7 @@
 
 
 
-/* Copy the first part of user declarations.  */
-/* Line 371 of yacc.c  */
+/* First part of user prologue.  */
 #line 1 "asm/semantics.ypp"
 
 #include "sim/types.h"
@@ -73,138 +77,216 @@ void yyerror(const char*);
 extern int32_t yylineno;
 int32_t yylex();
 extern codegen * cgen;
+static byte branch_hint = HINT_NONE; // set by a .t/.nt suffix on the current branch
+static bool is_branch = false;       // the current instruction is a conditional branch
 short inline PACK_OPERANDS(byte x, byte y, byte z) {
   return  x      & (uint16_t)0x001F | 
          (y<<5)  & (uint16_t)0x03e0 | 
          (z<<10) & (uint16_t)0x7C00;
   }
 
-/* Line 371 of yacc.c  */
-#line 84 "rasm.tab.cpp"
+#line 89 "rasm.tab.cpp"
 
-# ifndef YY_NULL
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULL nullptr
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
 #  else
-#   define YY_NULL 0
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
+#include "rasm.tab.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NEWLINE = 3,                    /* NEWLINE  */
+  YYSYMBOL_TEXT_SECTION = 4,               /* TEXT_SECTION  */
+  YYSYMBOL_DATA_SECTION = 5,               /* DATA_SECTION  */
+  YYSYMBOL_LABELDECL = 6,                  /* LABELDECL  */
+  YYSYMBOL_INTEGER = 7,                    /* INTEGER  */
+  YYSYMBOL_LABELREF = 8,                   /* LABELREF  */
+  YYSYMBOL_REGISTER = 9,                   /* REGISTER  */
+  YYSYMBOL_INVALID_REGISTER = 10,          /* INVALID_REGISTER  */
+  YYSYMBOL_ADDI = 11,                      /* ADDI  */
+  YYSYMBOL_ADD = 12,                       /* ADD  */
+  YYSYMBOL_SUBI = 13,                      /* SUBI  */
+  YYSYMBOL_BRANCH = 14,                    /* BRANCH  */
+  YYSYMBOL_BRANCHEQZ = 15,                 /* BRANCHEQZ  */
+  YYSYMBOL_BRANCHGE = 16,                  /* BRANCHGE  */
+  YYSYMBOL_BRANCHNE = 17,                  /* BRANCHNE  */
+  YYSYMBOL_LOADADDR = 18,                  /* LOADADDR  */
+  YYSYMBOL_LOADBYTE = 19,                  /* LOADBYTE  */
+  YYSYMBOL_LOADIMMED = 20,                 /* LOADIMMED  */
+  YYSYMBOL_SYSCALL = 21,                   /* SYSCALL  */
+  YYSYMBOL_NOOP = 22,                      /* NOOP  */
+  YYSYMBOL_WORD = 23,                      /* WORD  */
+  YYSYMBOL_BYTE = 24,                      /* BYTE  */
+  YYSYMBOL_SPACE = 25,                     /* SPACE  */
+  YYSYMBOL_ASCII = 26,                     /* ASCII  */
+  YYSYMBOL_ASCIIZ = 27,                    /* ASCIIZ  */
+  YYSYMBOL_STRING = 28,                    /* STRING  */
+  YYSYMBOL_SECTION_IDENT = 29,             /* SECTION_IDENT  */
+  YYSYMBOL_HINT_TAKEN_SUFFIX = 30,         /* HINT_TAKEN_SUFFIX  */
+  YYSYMBOL_HINT_NOT_TAKEN_SUFFIX = 31,     /* HINT_NOT_TAKEN_SUFFIX  */
+  YYSYMBOL_MUL = 32,                       /* MUL  */
+  YYSYMBOL_DIV = 33,                       /* DIV  */
+  YYSYMBOL_REM = 34,                       /* REM  */
+  YYSYMBOL_LOADWORD = 35,                  /* LOADWORD  */
+  YYSYMBOL_STOREBYTE = 36,                 /* STOREBYTE  */
+  YYSYMBOL_STOREWORD = 37,                 /* STOREWORD  */
+  YYSYMBOL_38_ = 38,                       /* '('  */
+  YYSYMBOL_39_ = 39,                       /* ')'  */
+  YYSYMBOL_40_ = 40,                       /* ','  */
+  YYSYMBOL_YYACCEPT = 41,                  /* $accept  */
+  YYSYMBOL_program = 42,                   /* program  */
+  YYSYMBOL_statements = 43,                /* statements  */
+  YYSYMBOL_addressable = 44,               /* addressable  */
+  YYSYMBOL_dataelement = 45,               /* dataelement  */
+  YYSYMBOL_labeldec = 46,                  /* labeldec  */
+  YYSYMBOL_offset = 47,                    /* offset  */
+  YYSYMBOL_rsrc1 = 48,                     /* rsrc1  */
+  YYSYMBOL_rsrc2 = 49,                     /* rsrc2  */
+  YYSYMBOL_rdest = 50,                     /* rdest  */
+  YYSYMBOL_hint = 51,                      /* hint  */
+  YYSYMBOL_address = 52,                   /* address  */
+  YYSYMBOL_statement = 53,                 /* statement  */
+  YYSYMBOL_instruction = 54,               /* instruction  */
+  YYSYMBOL_55_1 = 55,                      /* $@1  */
+  YYSYMBOL_56_2 = 56,                      /* $@2  */
+  YYSYMBOL_57_3 = 57,                      /* $@3  */
+  YYSYMBOL_58_4 = 58,                      /* $@4  */
+  YYSYMBOL_59_5 = 59,                      /* $@5  */
+  YYSYMBOL_60_6 = 60,                      /* $@6  */
+  YYSYMBOL_61_7 = 61,                      /* $@7  */
+  YYSYMBOL_62_8 = 62,                      /* $@8  */
+  YYSYMBOL_63_9 = 63,                      /* $@9  */
+  YYSYMBOL_64_10 = 64,                     /* $@10  */
+  YYSYMBOL_65_11 = 65,                     /* $@11  */
+  YYSYMBOL_66_12 = 66,                     /* $@12  */
+  YYSYMBOL_67_13 = 67,                     /* $@13  */
+  YYSYMBOL_68_14 = 68,                     /* $@14  */
+  YYSYMBOL_69_15 = 69,                     /* $@15  */
+  YYSYMBOL_70_16 = 70,                     /* $@16  */
+  YYSYMBOL_71_17 = 71,                     /* $@17  */
+  YYSYMBOL_72_18 = 72,                     /* $@18  */
+  YYSYMBOL_73_19 = 73,                     /* $@19  */
+  YYSYMBOL_74_20 = 74,                     /* $@20  */
+  YYSYMBOL_75_21 = 75,                     /* $@21  */
+  YYSYMBOL_word = 76,                      /* word  */
+  YYSYMBOL_byte = 77,                      /* byte  */
+  YYSYMBOL_space = 78,                     /* space  */
+  YYSYMBOL_ascii = 79,                     /* ascii  */
+  YYSYMBOL_asciiz = 80,                    /* asciiz  */
+  YYSYMBOL_integers = 81,                  /* integers  */
+  YYSYMBOL_bytes = 82                      /* bytes  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
-/* In a future release of Bison, this section will be replaced
-   by #include "rasm.tab.hpp".  */
-#ifndef YY_YY_RASM_TAB_HPP_INCLUDED
-# define YY_YY_RASM_TAB_HPP_INCLUDED
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 1
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NEWLINE = 258,
-     TEXT_SECTION = 259,
-     DATA_SECTION = 260,
-     LABELDECL = 261,
-     INTEGER = 262,
-     LABELREF = 263,
-     REGISTER = 264,
-     INVALID_REGISTER = 265,
-     ADDI = 266,
-     ADD = 267,
-     SUBI = 268,
-     BRANCH = 269,
-     BRANCHEQZ = 270,
-     BRANCHGE = 271,
-     BRANCHNE = 272,
-     LOADADDR = 273,
-     LOADBYTE = 274,
-     LOADIMMED = 275,
-     SYSCALL = 276,
-     NOOP = 277,
-     WORD = 278,
-     BYTE = 279,
-     SPACE = 280,
-     ASCII = 281,
-     ASCIIZ = 282,
-     STRING = 283,
-     SECTION_IDENT = 284
-   };
-#endif
 
+#ifdef short
+# undef short
+#endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-extern YYSTYPE yylval;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
-int yyparse ();
+typedef signed char yytype_int8;
 #endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-int yyparse ();
+typedef short yytype_int16;
 #endif
-#endif /* ! YYPARSE_PARAM */
-
-#endif /* !YY_YY_RASM_TAB_HPP_INCLUDED  */
-
-/* Copy the second part of user declarations.  */
-
-/* Line 390 of yacc.c  */
-#line 178 "rasm.tab.cpp"
 
-#ifdef short
-# undef short
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
 typedef unsigned char yytype_uint8;
-#endif
-
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
 #else
-typedef short int yytype_int8;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef int yytype_uint16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -212,16 +294,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -235,32 +329,71 @@ typedef short int yytype_int16;
 # endif
 #endif
 
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(N) (N)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -277,8 +410,7 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
       /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
@@ -290,8 +422,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -307,7 +439,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -315,40 +447,37 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -358,16 +487,16 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
@@ -377,16 +506,16 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
-      while (YYID (0))
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
@@ -394,32 +523,37 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  9
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   91
+#define YYLAST   124
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  33
+#define YYNTOKENS  41
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  35
+#define YYNNTS  42
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  73
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  123
+#define YYNRULES  88
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  164
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   284
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   292
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      30,    31,     2,     2,    32,     2,     2,     2,     2,     2,
+      38,    39,     2,     2,    40,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -443,297 +577,260 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
-      25,    26,    27,    28,    29
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     5,     7,    11,    13,    15,    17,    19,
-      21,    23,    25,    27,    28,    30,    35,    39,    41,    43,
-      45,    47,    49,    51,    53,    55,    57,    59,    61,    63,
-      65,    68,    70,    71,    72,    81,    82,    90,    91,    92,
-     101,   102,   103,   112,   113,   114,   123,   124,   130,   131,
-     132,   139,   140,   141,   148,   153,   154,   158,   160,   162,
-     164,   167,   170,   173,   176,   179,   182,   185,   188,   191,
-     194,   196,   199,   201
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      34,     0,    -1,    35,    -1,    44,    -1,    35,     3,    44,
-      -1,    37,    -1,    45,    -1,    61,    -1,    62,    -1,    63,
-      -1,    64,    -1,    65,    -1,     1,    -1,    -1,     6,    -1,
-       7,    30,     9,    31,    -1,    30,     9,    31,    -1,     1,
-      -1,     9,    -1,     1,    -1,     9,    -1,     1,    -1,     9,
-      -1,     1,    -1,     7,    -1,     8,    -1,     1,    -1,     4,
-      -1,     5,    -1,    38,    -1,    38,    36,    -1,    29,    -1,
-      -1,    -1,    11,    46,    42,    32,    40,    47,    32,     7,
-      -1,    -1,    12,    48,    42,    32,    40,    32,    41,    -1,
-      -1,    -1,    13,    49,    42,    32,    40,    50,    32,     7,
-      -1,    -1,    -1,    16,    51,    40,    32,    41,    32,    52,
-      43,    -1,    -1,    -1,    17,    53,    40,    32,    41,    32,
-      54,    43,    -1,    -1,    19,    55,    42,    32,    39,    -1,
-      -1,    -1,    18,    56,    42,    32,    57,    43,    -1,    -1,
-      -1,    15,    58,    40,    32,    59,    43,    -1,    20,    42,
-      32,     7,    -1,    -1,    14,    60,    43,    -1,    21,    -1,
-      22,    -1,     8,    -1,    23,    66,    -1,    23,     1,    -1,
-      24,    67,    -1,    24,     1,    -1,    25,     7,    -1,    25,
-       1,    -1,    26,    28,    -1,    26,     1,    -1,    27,    28,
-      -1,    27,     1,    -1,     7,    -1,    66,     7,    -1,     7,
-      -1,    67,     7,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    25,    25,    28,    29,    32,    33,    36,    37,    38,
-      39,    40,    41,    46,    47,    50,    51,    52,    57,    58,
-      61,    62,    65,    66,    69,    70,    71,    76,    77,    78,
-      79,    80,    86,    86,    86,    89,    89,    92,    93,    92,
-      97,    98,    97,   100,   101,   100,   103,   103,   108,   109,
-     108,   111,   112,   111,   114,   119,   119,   121,   124,   127,
-     133,   134,   139,   140,   145,   146,   151,   152,   157,   158,
-     163,   164,   167,   168
+       0,    29,    29,    32,    33,    36,    37,    45,    46,    47,
+      48,    49,    50,    55,    56,    59,    60,    61,    66,    67,
+      70,    71,    74,    75,    78,    79,    80,    83,    84,    85,
+      90,    91,    92,    93,    94,   100,   100,   100,   103,   103,
+     106,   106,   109,   109,   112,   112,   115,   116,   115,   120,
+     121,   120,   123,   124,   123,   126,   126,   131,   131,   136,
+     136,   141,   141,   146,   147,   146,   149,   150,   149,   152,
+     157,   157,   162,   165,   168,   174,   175,   180,   181,   186,
+     187,   192,   193,   198,   199,   204,   205,   208,   209
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "NEWLINE", "TEXT_SECTION",
-  "DATA_SECTION", "LABELDECL", "INTEGER", "LABELREF", "REGISTER",
-  "INVALID_REGISTER", "ADDI", "ADD", "SUBI", "BRANCH", "BRANCHEQZ",
-  "BRANCHGE", "BRANCHNE", "LOADADDR", "LOADBYTE", "LOADIMMED", "SYSCALL",
-  "NOOP", "WORD", "BYTE", "SPACE", "ASCII", "ASCIIZ", "STRING",
-  "SECTION_IDENT", "'('", "')'", "','", "$accept", "program", "statements",
-  "addressable", "dataelement", "labeldec", "offset", "rsrc1", "rsrc2",
-  "rdest", "address", "statement", "instruction", "$@1", "$@2", "$@3",
-  "$@4", "$@5", "$@6", "$@7", "$@8", "$@9", "$@10", "$@11", "$@12", "$@13",
-  "$@14", "$@15", "word", "byte", "space", "ascii", "asciiz", "integers",
-  "bytes", YY_NULL
+  "\"end of file\"", "error", "\"invalid token\"", "NEWLINE",
+  "TEXT_SECTION", "DATA_SECTION", "LABELDECL", "INTEGER", "LABELREF",
+  "REGISTER", "INVALID_REGISTER", "ADDI", "ADD", "SUBI", "BRANCH",
+  "BRANCHEQZ", "BRANCHGE", "BRANCHNE", "LOADADDR", "LOADBYTE", "LOADIMMED",
+  "SYSCALL", "NOOP", "WORD", "BYTE", "SPACE", "ASCII", "ASCIIZ", "STRING",
+  "SECTION_IDENT", "HINT_TAKEN_SUFFIX", "HINT_NOT_TAKEN_SUFFIX", "MUL",
+  "DIV", "REM", "LOADWORD", "STOREBYTE", "STOREWORD", "'('", "')'", "','",
+  "$accept", "program", "statements", "addressable", "dataelement",
+  "labeldec", "offset", "rsrc1", "rsrc2", "rdest", "hint", "address",
+  "statement", "instruction", "$@1", "$@2", "$@3", "$@4", "$@5", "$@6",
+  "$@7", "$@8", "$@9", "$@10", "$@11", "$@12", "$@13", "$@14", "$@15",
+  "$@16", "$@17", "$@18", "$@19", "$@20", "$@21", "word", "byte", "space",
+  "ascii", "asciiz", "integers", "bytes", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-      40,    41,    44
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-109)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-33)
+
+#define yytable_value_is_error(Yyn) \
+  0
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
 {
-       0,    33,    34,    35,    35,    36,    36,    37,    37,    37,
-      37,    37,    37,    38,    38,    39,    39,    39,    40,    40,
-      41,    41,    42,    42,    43,    43,    43,    44,    44,    44,
-      44,    44,    46,    47,    45,    48,    45,    49,    50,    45,
-      51,    52,    45,    53,    54,    45,    55,    45,    56,    57,
-      45,    58,    59,    45,    45,    60,    45,    45,    45,    45,
-      61,    61,    62,    62,    63,    63,    64,    64,    65,    65,
-      66,    66,    67,    67
+      35,  -109,  -109,  -109,  -109,     3,     7,     1,  -109,  -109,
+      35,  -109,  -109,  -109,  -109,  -109,  -109,    20,    20,    20,
+    -109,  -109,    51,  -109,  -109,    80,    92,    93,    30,    43,
+    -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,
+    -109,  -109,  -109,  -109,  -109,    51,    51,    51,    84,  -109,
+    -109,  -109,  -109,  -109,    51,    51,  -109,  -109,   -10,  -109,
+    -109,    25,  -109,  -109,    63,  -109,  -109,  -109,  -109,  -109,
+    -109,    51,    51,    51,    51,    52,    52,    42,    44,    46,
+    -109,  -109,  -109,  -109,    71,    71,    71,    55,    56,    76,
+    -109,  -109,    57,    58,    61,    62,  -109,  -109,    64,    65,
+      71,    71,    71,  -109,  -109,    66,    67,    68,  -109,     4,
+    -109,    71,    71,    71,     4,     4,     4,  -109,    69,  -109,
+    -109,    52,    52,    84,  -109,    72,    94,  -109,    73,    74,
+      75,  -109,  -109,  -109,    77,    52,    78,    84,    79,    81,
+    -109,   102,    83,    52,    52,    52,   105,  -109,   109,  -109,
+    -109,  -109,    85,  -109,  -109,  -109,  -109,  -109,  -109,    84,
+      84,  -109,  -109,  -109
 };
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,     2,     1,     1,     3,     1,     1,     1,     1,     1,
-       1,     1,     1,     0,     1,     4,     3,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       2,     1,     0,     0,     8,     0,     7,     0,     0,     8,
-       0,     0,     8,     0,     0,     8,     0,     5,     0,     0,
-       6,     0,     0,     6,     4,     0,     3,     1,     1,     1,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       1,     2,     1,     2
+      13,    30,    31,    14,    34,     0,     2,     0,     3,     1,
+      13,    12,    74,    35,    38,    46,    70,    24,    24,    24,
+      63,    55,     0,    72,    73,     0,     0,     0,     0,     0,
+      40,    42,    44,    57,    59,    61,    33,     5,     6,     7,
+       8,     9,    10,    11,     4,     0,     0,     0,     0,    25,
+      26,    66,    49,    52,     0,     0,    23,    22,     0,    76,
+      85,    75,    78,    87,    77,    80,    79,    82,    81,    84,
+      83,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      29,    27,    28,    71,     0,     0,     0,     0,     0,     0,
+      86,    88,     0,     0,     0,     0,    21,    20,     0,     0,
+       0,     0,     0,    19,    18,     0,     0,     0,    64,     0,
+      69,     0,     0,     0,     0,     0,     0,    36,     0,    47,
+      67,     0,     0,     0,    17,     0,     0,    56,     0,     0,
+       0,    58,    60,    62,     0,     0,     0,     0,     0,     0,
+      65,     0,     0,     0,     0,     0,     0,    39,     0,    68,
+      50,    53,     0,    16,    41,    43,    45,    37,    48,     0,
+       0,    15,    51,    54
 };
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
 {
-      13,    27,    28,    14,    31,     0,     2,     0,     3,     1,
-      13,    12,    59,    32,    35,    37,    55,    51,    40,    43,
-      48,    46,     0,    57,    58,     0,     0,     0,     0,     0,
-      30,     5,     6,     7,     8,     9,    10,    11,     4,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    23,    22,
-       0,    61,    70,    60,    63,    72,    62,    65,    64,    67,
-      66,    69,    68,     0,     0,     0,    26,    24,    25,    56,
-      19,    18,     0,     0,     0,     0,     0,     0,    71,    73,
-       0,     0,     0,    52,     0,     0,    49,     0,    54,    33,
-       0,    38,     0,    21,    20,     0,     0,     0,    17,     0,
-       0,    47,     0,     0,     0,    53,    41,    44,    50,     0,
-       0,     0,    36,     0,     0,     0,     0,    16,    34,    39,
-      42,    45,    15
+    -109,  -109,  -109,  -109,  -109,  -109,  -108,   -23,   -76,     2,
+      36,   -94,   110,  -109,  -109,  -109,  -109,  -109,  -109,  -109,
+    -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,
+    -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,
+    -109,  -109
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,     5,     6,    30,    31,     7,   101,    72,    95,    50,
-      69,     8,    32,    39,   102,    40,    41,   104,    44,   114,
-      45,   115,    47,    46,    97,    43,    92,    42,    33,    34,
-      35,    36,    37,    53,    56
+       0,     5,     6,    36,    37,     7,   127,   105,    98,    58,
+      51,    83,     8,    38,    45,   134,    46,    71,    72,    73,
+      47,   136,    85,   159,    86,   160,    55,    74,    75,    76,
+      54,   123,    84,   137,    48,    39,    40,    41,    42,    43,
+      61,    64
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -53
-static const yytype_int8 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-      35,   -53,   -53,   -53,   -53,     9,     7,     3,   -53,   -53,
-      35,   -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,
-     -53,   -53,    41,   -53,   -53,    60,    67,    68,     4,     6,
-     -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,    41,
-      41,    41,    55,    46,    46,    46,    41,    41,   -53,   -53,
-     -20,   -53,   -53,    28,   -53,   -53,    37,   -53,   -53,   -53,
-     -53,   -53,   -53,   -19,    14,    26,   -53,   -53,   -53,   -53,
-     -53,   -53,    38,    39,    40,    44,    45,    66,   -53,   -53,
-      46,    46,    46,   -53,    48,    48,   -53,     1,   -53,   -53,
-      47,   -53,    55,   -53,   -53,    49,    50,    55,   -53,    15,
-      69,   -53,    51,    48,    52,   -53,   -53,   -53,   -53,    71,
-      54,    79,   -53,    80,    55,    55,    57,   -53,   -53,   -53,
-     -53,   -53,   -53
+      99,   -32,    11,     9,   -32,   124,   131,   132,   133,    12,
+      10,   125,    13,    14,    15,    16,    17,    18,    19,    20,
+      21,    22,    23,    24,    25,    26,    27,    28,    29,   140,
+      89,    67,    90,    30,    31,    32,    33,    34,    35,     1,
+       2,     3,   126,   149,    69,   138,   139,    77,    78,    79,
+      49,    50,    56,    96,    52,    53,    87,    88,    68,   147,
+      57,    97,   106,   107,     4,   162,   163,   154,   155,   156,
+      91,    70,   103,    92,    93,    94,    95,   117,   118,   119,
+     104,    59,   100,   110,   101,    80,   102,    60,   128,   129,
+     130,    81,    82,    62,    65,   108,   109,   111,   112,    63,
+      66,   113,   114,   142,   115,   116,   120,   121,   122,   135,
+     141,   152,   157,   143,   144,   145,   158,   146,   148,   150,
+      44,   151,   153,     0,   161
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int16 yycheck[] =
 {
-     -53,   -53,   -53,   -53,   -53,   -53,   -53,   -44,   -52,    13,
-     -49,    81,   -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,
-     -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,   -53,
-     -53,   -53,   -53,   -53,   -53
+      76,     0,     1,     0,     3,     1,   114,   115,   116,     8,
+       3,     7,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,   123,
+      40,     1,     7,    32,    33,    34,    35,    36,    37,     4,
+       5,     6,    38,   137,     1,   121,   122,    45,    46,    47,
+      30,    31,     1,     1,    18,    19,    54,    55,    28,   135,
+       9,     9,    85,    86,    29,   159,   160,   143,   144,   145,
+       7,    28,     1,    71,    72,    73,    74,   100,   101,   102,
+       9,     1,    40,     7,    40,     1,    40,     7,   111,   112,
+     113,     7,     8,     1,     1,    40,    40,    40,    40,     7,
+       7,    40,    40,     9,    40,    40,    40,    40,    40,    40,
+      38,     9,     7,    40,    40,    40,     7,    40,    40,    40,
+      10,    40,    39,    -1,    39
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -30
-static const yytype_int8 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-      73,    74,    98,   -29,    11,    59,   -29,    61,    99,     9,
-      10,    12,    77,    80,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,   100,    60,    96,    62,    78,    89,    90,    91,     1,
-       2,     3,    48,   105,    79,   109,    81,    70,   108,    93,
-      49,   112,    63,    64,    65,    71,    66,    94,    82,    75,
-      76,    51,    67,    68,     4,   120,   121,    52,    54,    57,
-      83,    84,    85,    88,    55,    58,    86,    87,   110,   103,
-     116,   106,   107,   111,   113,   117,   118,   119,   122,     0,
-       0,    38
+       0,     4,     5,     6,    29,    42,    43,    46,    53,     0,
+       3,     1,     8,    11,    12,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
+      32,    33,    34,    35,    36,    37,    44,    45,    54,    76,
+      77,    78,    79,    80,    53,    55,    57,    61,    75,    30,
+      31,    51,    51,    51,    71,    67,     1,     9,    50,     1,
+       7,    81,     1,     7,    82,     1,     7,     1,    28,     1,
+      28,    58,    59,    60,    68,    69,    70,    50,    50,    50,
+       1,     7,     8,    52,    73,    63,    65,    50,    50,    40,
+       7,     7,    50,    50,    50,    50,     1,     9,    49,    49,
+      40,    40,    40,     1,     9,    48,    48,    48,    40,    40,
+       7,    40,    40,    40,    40,    40,    40,    48,    48,    48,
+      40,    40,    40,    72,     1,     7,    38,    47,    48,    48,
+      48,    47,    47,    47,    56,    40,    62,    74,    49,    49,
+      52,    38,     9,    40,    40,    40,    40,    49,    40,    52,
+      40,    40,     9,    39,    49,    49,    49,     7,     7,    64,
+      66,    39,    52,    52
 };
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-53)))
-
-#define yytable_value_is_error(Yytable_value) \
-  YYID (0)
-
-static const yytype_int8 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-      44,    45,     1,     0,     1,     1,     3,     1,     7,     0,
-       3,     8,    32,    32,    11,    12,    13,    14,    15,    16,
-      17,    18,    19,    20,    21,    22,    23,    24,    25,    26,
-      27,    30,    28,    85,    28,     7,    80,    81,    82,     4,
-       5,     6,     1,    92,     7,    30,    32,     1,    97,     1,
-       9,   103,    39,    40,    41,     9,     1,     9,    32,    46,
-      47,     1,     7,     8,    29,   114,   115,     7,     1,     1,
-      32,    32,    32,     7,     7,     7,    32,    32,     9,    32,
-       9,    32,    32,    32,    32,    31,     7,     7,    31,    -1,
-      -1,    10
+       0,    41,    42,    43,    43,    44,    44,    45,    45,    45,
+      45,    45,    45,    46,    46,    47,    47,    47,    48,    48,
+      49,    49,    50,    50,    51,    51,    51,    52,    52,    52,
+      53,    53,    53,    53,    53,    55,    56,    54,    57,    54,
+      58,    54,    59,    54,    60,    54,    61,    62,    54,    63,
+      64,    54,    65,    66,    54,    67,    54,    68,    54,    69,
+      54,    70,    54,    71,    72,    54,    73,    74,    54,    54,
+      75,    54,    54,    54,    54,    76,    76,    77,    77,    78,
+      78,    79,    79,    80,    80,    81,    81,    82,    82
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,     4,     5,     6,    29,    34,    35,    38,    44,     0,
-       3,     1,     8,    11,    12,    13,    14,    15,    16,    17,
-      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      36,    37,    45,    61,    62,    63,    64,    65,    44,    46,
-      48,    49,    60,    58,    51,    53,    56,    55,     1,     9,
-      42,     1,     7,    66,     1,     7,    67,     1,     7,     1,
-      28,     1,    28,    42,    42,    42,     1,     7,     8,    43,
-       1,     9,    40,    40,    40,    42,    42,    32,     7,     7,
-      32,    32,    32,    32,    32,    32,    32,    32,     7,    40,
-      40,    40,    59,     1,     9,    41,    41,    57,     1,     7,
-      30,    39,    47,    32,    50,    43,    32,    32,    43,    30,
-       9,    32,    41,    32,    52,    54,     9,    31,     7,     7,
-      43,    43,    31
+       0,     2,     1,     1,     3,     1,     1,     1,     1,     1,
+       1,     1,     1,     0,     1,     4,     3,     1,     1,     1,
+       1,     1,     1,     1,     0,     1,     1,     1,     1,     1,
+       1,     1,     1,     2,     1,     0,     0,     8,     0,     7,
+       0,     7,     0,     7,     0,     7,     0,     0,     8,     0,
+       0,     9,     0,     0,     9,     0,     5,     0,     5,     0,
+       5,     0,     5,     0,     0,     6,     0,     0,     7,     4,
+       0,     3,     1,     1,     1,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     1,     2,     1,     2
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
 
-#define YYRECOVERING()  (!!yyerrstatus)
+enum { YYENOMEM = -2 };
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-/* Error token number */
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -743,82 +840,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -826,16 +899,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -846,63 +911,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -918,363 +976,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULL, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULL;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULL, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
-    {
-
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-
-#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END
-#endif
-#ifndef YY_INITIAL_VALUE
-# define YY_INITIAL_VALUE(Value) /* Nothing. */
-#endif
-
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval YY_INITIAL_VALUE(yyval_default);
-
+YYSTYPE yylval;
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1282,102 +1054,107 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1388,18 +1165,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1427,15 +1215,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1450,14 +1236,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1470,345 +1256,452 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 6:
-/* Line 1792 of yacc.c  */
-#line 33 "asm/semantics.ypp"
-    { cgen->emit<byte>(0); /* just rounding off to 8 bytes per instruction */ }
+  case 6: /* addressable: instruction  */
+#line 37 "asm/semantics.ypp"
+                           {
+                 // the byte rounding off to 8 bytes per instruction carries the static branch hint
+                 cgen->emit<byte>(cgen->hint_for(cgen->address() - 7, is_branch, branch_hint));
+                 branch_hint = HINT_NONE;
+                 is_branch = false;
+               }
+#line 1268 "rasm.tab.cpp"
     break;
 
-  case 12:
-/* Line 1792 of yacc.c  */
-#line 41 "asm/semantics.ypp"
-    {
+  case 12: /* dataelement: error  */
+#line 50 "asm/semantics.ypp"
+                     {
                cout << "invalid data element; line " << yylineno << endl; exit(11);
              }
+#line 1276 "rasm.tab.cpp"
     break;
 
-  case 14:
-/* Line 1792 of yacc.c  */
-#line 47 "asm/semantics.ypp"
-    { cgen->label_here((yyvsp[(1) - (1)].sysstring).ptr); }
+  case 14: /* labeldec: LABELDECL  */
+#line 56 "asm/semantics.ypp"
+                               { cgen->label_here((yyvsp[0].sysstring).ptr); }
+#line 1282 "rasm.tab.cpp"
     break;
 
-  case 15:
-/* Line 1792 of yacc.c  */
-#line 50 "asm/semantics.ypp"
-    { sys_offset s = {(yyvsp[(3) - (4)].sysword), (yyvsp[(1) - (4)].sysword)};  (yyval.sysoffset) = s; }
+  case 15: /* offset: INTEGER '(' REGISTER ')'  */
+#line 59 "asm/semantics.ypp"
+                                         { sys_offset s = {(yyvsp[-1].sysword), (yyvsp[-3].sysword)};  (yyval.sysoffset) = s; }
+#line 1288 "rasm.tab.cpp"
     break;
 
-  case 16:
-/* Line 1792 of yacc.c  */
-#line 51 "asm/semantics.ypp"
-    { sys_offset s = {(yyvsp[(2) - (3)].sysword), 0};  (yyval.sysoffset) = s; }
+  case 16: /* offset: '(' REGISTER ')'  */
+#line 60 "asm/semantics.ypp"
+                                  { sys_offset s = {(yyvsp[-1].sysword), 0};  (yyval.sysoffset) = s; }
+#line 1294 "rasm.tab.cpp"
     break;
 
-  case 17:
-/* Line 1792 of yacc.c  */
-#line 52 "asm/semantics.ypp"
-    {
+  case 17: /* offset: error  */
+#line 61 "asm/semantics.ypp"
+                     {
                 cout << "invalid offset; line " << yylineno << endl;  exit(11);
              }
+#line 1302 "rasm.tab.cpp"
     break;
 
-  case 19:
-/* Line 1792 of yacc.c  */
-#line 58 "asm/semantics.ypp"
-    { cout << "expected first source register; line " << yylineno << endl; exit(11);}
+  case 19: /* rsrc1: error  */
+#line 67 "asm/semantics.ypp"
+                     { cout << "expected first source register; line " << yylineno << endl; exit(11);}
+#line 1308 "rasm.tab.cpp"
     break;
 
-  case 21:
-/* Line 1792 of yacc.c  */
-#line 62 "asm/semantics.ypp"
-    { cout << "expected second source register; line " << yylineno << endl; exit(11);}
+  case 21: /* rsrc2: error  */
+#line 71 "asm/semantics.ypp"
+                     { cout << "expected second source register; line " << yylineno << endl; exit(11);}
+#line 1314 "rasm.tab.cpp"
     break;
 
-  case 23:
-/* Line 1792 of yacc.c  */
-#line 66 "asm/semantics.ypp"
-    { cout << "expected destination register; line " << yylineno << endl; exit(11);}
+  case 23: /* rdest: error  */
+#line 75 "asm/semantics.ypp"
+                     { cout << "expected destination register; line " << yylineno << endl; exit(11);}
+#line 1320 "rasm.tab.cpp"
     break;
 
-  case 24:
-/* Line 1792 of yacc.c  */
-#line 69 "asm/semantics.ypp"
-    { cgen->emit<uint32_t>((yyvsp[(1) - (1)].sysword)); }
+  case 25: /* hint: HINT_TAKEN_SUFFIX  */
+#line 79 "asm/semantics.ypp"
+                                     { branch_hint = HINT_TAKEN; }
+#line 1326 "rasm.tab.cpp"
     break;
 
-  case 25:
-/* Line 1792 of yacc.c  */
-#line 70 "asm/semantics.ypp"
-    { cgen->emit_label_address((yyvsp[(1) - (1)].sysstring).ptr); }
+  case 26: /* hint: HINT_NOT_TAKEN_SUFFIX  */
+#line 80 "asm/semantics.ypp"
+                                     { branch_hint = HINT_NOT_TAKEN; }
+#line 1332 "rasm.tab.cpp"
     break;
 
-  case 26:
-/* Line 1792 of yacc.c  */
-#line 71 "asm/semantics.ypp"
-    {
+  case 27: /* address: INTEGER  */
+#line 83 "asm/semantics.ypp"
+                               { cgen->emit<uint32_t>((yyvsp[0].sysword)); }
+#line 1338 "rasm.tab.cpp"
+    break;
+
+  case 28: /* address: LABELREF  */
+#line 84 "asm/semantics.ypp"
+                               { cgen->emit_label_address((yyvsp[0].sysstring).ptr); }
+#line 1344 "rasm.tab.cpp"
+    break;
+
+  case 29: /* address: error  */
+#line 85 "asm/semantics.ypp"
+                     {
                 cout << "invalid address; line " << yylineno << endl;  exit(11);
              }
+#line 1352 "rasm.tab.cpp"
     break;
 
-  case 27:
-/* Line 1792 of yacc.c  */
-#line 76 "asm/semantics.ypp"
-    { cgen->in_text_section(); }
+  case 30: /* statement: TEXT_SECTION  */
+#line 90 "asm/semantics.ypp"
+                               { cgen->in_text_section(); }
+#line 1358 "rasm.tab.cpp"
     break;
 
-  case 28:
-/* Line 1792 of yacc.c  */
-#line 77 "asm/semantics.ypp"
-    { cgen->in_data_section(); }
+  case 31: /* statement: DATA_SECTION  */
+#line 91 "asm/semantics.ypp"
+                               { cgen->in_data_section(); }
+#line 1364 "rasm.tab.cpp"
     break;
 
-  case 31:
-/* Line 1792 of yacc.c  */
-#line 80 "asm/semantics.ypp"
-    {
+  case 34: /* statement: SECTION_IDENT  */
+#line 94 "asm/semantics.ypp"
+                             {
                cout << "invalid section; line " << yylineno << endl; exit(10);
              }
+#line 1372 "rasm.tab.cpp"
     break;
 
-  case 32:
-/* Line 1792 of yacc.c  */
-#line 86 "asm/semantics.ypp"
-    { cgen->emit<byte>(1); }
+  case 35: /* $@1: %empty  */
+#line 100 "asm/semantics.ypp"
+                     { cgen->emit<byte>(1); }
+#line 1378 "rasm.tab.cpp"
     break;
 
-  case 33:
-/* Line 1792 of yacc.c  */
-#line 86 "asm/semantics.ypp"
-    { 
-                  cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[(3) - (5)].sysword), (yyvsp[(5) - (5)].sysword), 0)); }
+  case 36: /* $@2: %empty  */
+#line 100 "asm/semantics.ypp"
+                                                              { 
+                  cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-2].sysword), (yyvsp[0].sysword), 0)); }
+#line 1385 "rasm.tab.cpp"
     break;
 
-  case 34:
-/* Line 1792 of yacc.c  */
-#line 88 "asm/semantics.ypp"
-    { cgen->emit<uint32_t>((yyvsp[(8) - (8)].sysword)); }
+  case 37: /* instruction: ADDI $@1 rdest ',' rsrc1 $@2 ',' INTEGER  */
+#line 102 "asm/semantics.ypp"
+                          { cgen->emit<uint32_t>((yyvsp[0].sysword)); }
+#line 1391 "rasm.tab.cpp"
     break;
 
-  case 35:
-/* Line 1792 of yacc.c  */
-#line 89 "asm/semantics.ypp"
-    { cgen->emit<byte>(9); }
+  case 38: /* $@3: %empty  */
+#line 103 "asm/semantics.ypp"
+                      { cgen->emit<byte>(9); }
+#line 1397 "rasm.tab.cpp"
     break;
 
-  case 36:
-/* Line 1792 of yacc.c  */
-#line 89 "asm/semantics.ypp"
-    {
-                cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[(3) - (7)].sysword), (yyvsp[(5) - (7)].sysword), (yyvsp[(7) - (7)].sysword))); 
+  case 39: /* instruction: ADD $@3 rdest ',' rsrc1 ',' rsrc2  */
+#line 103 "asm/semantics.ypp"
+                                                                         {
+                cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-4].sysword), (yyvsp[-2].sysword), (yyvsp[0].sysword))); 
                 cgen->emit<uint32_t>(0); }
+#line 1405 "rasm.tab.cpp"
     break;
 
-  case 37:
-/* Line 1792 of yacc.c  */
-#line 92 "asm/semantics.ypp"
-    { cgen->emit<byte>(8); }
+  case 40: /* $@4: %empty  */
+#line 106 "asm/semantics.ypp"
+                      { cgen->emit<byte>(11); }
+#line 1411 "rasm.tab.cpp"
     break;
 
-  case 38:
-/* Line 1792 of yacc.c  */
-#line 93 "asm/semantics.ypp"
-    { cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[(3) - (5)].sysword), (yyvsp[(5) - (5)].sysword), 0)); }
+  case 41: /* instruction: MUL $@4 rdest ',' rsrc1 ',' rsrc2  */
+#line 106 "asm/semantics.ypp"
+                                                                          {
+                cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-4].sysword), (yyvsp[-2].sysword), (yyvsp[0].sysword)));
+                cgen->emit<uint32_t>(0); }
+#line 1419 "rasm.tab.cpp"
     break;
 
-  case 39:
-/* Line 1792 of yacc.c  */
-#line 94 "asm/semantics.ypp"
-    {
-                 cgen->emit<uint32_t>((yyvsp[(8) - (8)].sysword));
+  case 42: /* $@5: %empty  */
+#line 109 "asm/semantics.ypp"
+                      { cgen->emit<byte>(12); }
+#line 1425 "rasm.tab.cpp"
+    break;
+
+  case 43: /* instruction: DIV $@5 rdest ',' rsrc1 ',' rsrc2  */
+#line 109 "asm/semantics.ypp"
+                                                                          {
+                cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-4].sysword), (yyvsp[-2].sysword), (yyvsp[0].sysword)));
+                cgen->emit<uint32_t>(0); }
+#line 1433 "rasm.tab.cpp"
+    break;
+
+  case 44: /* $@6: %empty  */
+#line 112 "asm/semantics.ypp"
+                      { cgen->emit<byte>(13); }
+#line 1439 "rasm.tab.cpp"
+    break;
+
+  case 45: /* instruction: REM $@6 rdest ',' rsrc1 ',' rsrc2  */
+#line 112 "asm/semantics.ypp"
+                                                                          {
+                cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-4].sysword), (yyvsp[-2].sysword), (yyvsp[0].sysword)));
+                cgen->emit<uint32_t>(0); }
+#line 1447 "rasm.tab.cpp"
+    break;
+
+  case 46: /* $@7: %empty  */
+#line 115 "asm/semantics.ypp"
+                      { cgen->emit<byte>(8); }
+#line 1453 "rasm.tab.cpp"
+    break;
+
+  case 47: /* $@8: %empty  */
+#line 116 "asm/semantics.ypp"
+                               { cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-2].sysword), (yyvsp[0].sysword), 0)); }
+#line 1459 "rasm.tab.cpp"
+    break;
+
+  case 48: /* instruction: SUBI $@7 rdest ',' rsrc1 $@8 ',' INTEGER  */
+#line 117 "asm/semantics.ypp"
+                       {
+                 cgen->emit<uint32_t>((yyvsp[0].sysword));
                }
+#line 1467 "rasm.tab.cpp"
     break;
 
-  case 40:
-/* Line 1792 of yacc.c  */
-#line 97 "asm/semantics.ypp"
-    { cgen->emit<byte>(3); }
+  case 49: /* $@9: %empty  */
+#line 120 "asm/semantics.ypp"
+                             { cgen->emit<byte>(3); is_branch = true; }
+#line 1473 "rasm.tab.cpp"
     break;
 
-  case 41:
-/* Line 1792 of yacc.c  */
-#line 98 "asm/semantics.ypp"
-    { cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[(3) - (6)].sysword), (yyvsp[(5) - (6)].sysword))); }
+  case 50: /* $@10: %empty  */
+#line 121 "asm/semantics.ypp"
+                                   { cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[-3].sysword), (yyvsp[-1].sysword))); }
+#line 1479 "rasm.tab.cpp"
     break;
 
-  case 43:
-/* Line 1792 of yacc.c  */
-#line 100 "asm/semantics.ypp"
-    { cgen->emit<byte>(4); }
+  case 52: /* $@11: %empty  */
+#line 123 "asm/semantics.ypp"
+                             { cgen->emit<byte>(4); is_branch = true; }
+#line 1485 "rasm.tab.cpp"
+    break;
+
+  case 53: /* $@12: %empty  */
+#line 124 "asm/semantics.ypp"
+                                   { cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[-3].sysword), (yyvsp[-1].sysword))); }
+#line 1491 "rasm.tab.cpp"
     break;
 
-  case 44:
-/* Line 1792 of yacc.c  */
-#line 101 "asm/semantics.ypp"
-    { cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[(3) - (6)].sysword), (yyvsp[(5) - (6)].sysword))); }
+  case 55: /* $@13: %empty  */
+#line 126 "asm/semantics.ypp"
+                         { cgen->emit<byte>(6); }
+#line 1497 "rasm.tab.cpp"
     break;
 
-  case 46:
-/* Line 1792 of yacc.c  */
-#line 103 "asm/semantics.ypp"
-    { cgen->emit<byte>(6); }
+  case 56: /* instruction: LOADBYTE $@13 rdest ',' offset  */
+#line 127 "asm/semantics.ypp"
+                                   { 
+                 cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-2].sysword), (yyvsp[0].sysoffset).reg, 0)); 
+                 cgen->emit<uint32_t>((yyvsp[0].sysoffset).offset);
+               }
+#line 1506 "rasm.tab.cpp"
+    break;
+
+  case 57: /* $@14: %empty  */
+#line 131 "asm/semantics.ypp"
+                         { cgen->emit<byte>(16); }
+#line 1512 "rasm.tab.cpp"
     break;
 
-  case 47:
-/* Line 1792 of yacc.c  */
-#line 104 "asm/semantics.ypp"
-    { 
-                 cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[(3) - (5)].sysword), (yyvsp[(5) - (5)].sysoffset).reg, 0)); 
-                 cgen->emit<uint32_t>((yyvsp[(5) - (5)].sysoffset).offset);
+  case 58: /* instruction: LOADWORD $@14 rdest ',' offset  */
+#line 132 "asm/semantics.ypp"
+                                   {
+                 cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-2].sysword), (yyvsp[0].sysoffset).reg, 0));
+                 cgen->emit<uint32_t>((yyvsp[0].sysoffset).offset);
                }
+#line 1521 "rasm.tab.cpp"
     break;
 
-  case 48:
-/* Line 1792 of yacc.c  */
-#line 108 "asm/semantics.ypp"
-    { cgen->emit<byte>(5); }
+  case 59: /* $@15: %empty  */
+#line 136 "asm/semantics.ypp"
+                         { cgen->emit<byte>(14); }
+#line 1527 "rasm.tab.cpp"
     break;
 
-  case 49:
-/* Line 1792 of yacc.c  */
-#line 109 "asm/semantics.ypp"
-    { cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[(3) - (4)].sysword), 0, 0)); }
+  case 60: /* instruction: STOREBYTE $@15 rsrc2 ',' offset  */
+#line 137 "asm/semantics.ypp"
+                                   {
+                 cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[0].sysoffset).reg, (yyvsp[-2].sysword)));
+                 cgen->emit<uint32_t>((yyvsp[0].sysoffset).offset);
+               }
+#line 1536 "rasm.tab.cpp"
     break;
 
-  case 51:
-/* Line 1792 of yacc.c  */
-#line 111 "asm/semantics.ypp"
-    { cgen->emit<byte>(2); }
+  case 61: /* $@16: %empty  */
+#line 141 "asm/semantics.ypp"
+                         { cgen->emit<byte>(15); }
+#line 1542 "rasm.tab.cpp"
     break;
 
-  case 52:
-/* Line 1792 of yacc.c  */
-#line 112 "asm/semantics.ypp"
-    { cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[(3) - (4)].sysword), 0)); }
+  case 62: /* instruction: STOREWORD $@16 rsrc2 ',' offset  */
+#line 142 "asm/semantics.ypp"
+                                   {
+                 cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[0].sysoffset).reg, (yyvsp[-2].sysword)));
+                 cgen->emit<uint32_t>((yyvsp[0].sysoffset).offset);
+               }
+#line 1551 "rasm.tab.cpp"
     break;
 
-  case 54:
-/* Line 1792 of yacc.c  */
-#line 114 "asm/semantics.ypp"
-    {
+  case 63: /* $@17: %empty  */
+#line 146 "asm/semantics.ypp"
+                         { cgen->emit<byte>(5); }
+#line 1557 "rasm.tab.cpp"
+    break;
+
+  case 64: /* $@18: %empty  */
+#line 147 "asm/semantics.ypp"
+                         { cgen->emit<uint16_t>(PACK_OPERANDS((yyvsp[-1].sysword), 0, 0)); }
+#line 1563 "rasm.tab.cpp"
+    break;
+
+  case 66: /* $@19: %empty  */
+#line 149 "asm/semantics.ypp"
+                              { cgen->emit<byte>(2); is_branch = true; }
+#line 1569 "rasm.tab.cpp"
+    break;
+
+  case 67: /* $@20: %empty  */
+#line 150 "asm/semantics.ypp"
+                         { cgen->emit<uint16_t>(PACK_OPERANDS(0, (yyvsp[-1].sysword), 0)); }
+#line 1575 "rasm.tab.cpp"
+    break;
+
+  case 69: /* instruction: LOADIMMED rdest ',' INTEGER  */
+#line 152 "asm/semantics.ypp"
+                                           {
                  cgen->emit<byte>(7);
-                 cgen->emit<short>(PACK_OPERANDS((yyvsp[(2) - (4)].sysword), 0, 0));
-                 cgen->emit<uint32_t>((yyvsp[(4) - (4)].sysword));
+                 cgen->emit<short>(PACK_OPERANDS((yyvsp[-2].sysword), 0, 0));
+                 cgen->emit<uint32_t>((yyvsp[0].sysword));
                }
+#line 1585 "rasm.tab.cpp"
     break;
 
-  case 55:
-/* Line 1792 of yacc.c  */
-#line 119 "asm/semantics.ypp"
-    { cgen->emit<byte>(2); cgen->emit<short>(0); }
+  case 70: /* $@21: %empty  */
+#line 157 "asm/semantics.ypp"
+                      {
+                 // beqz $0: always taken, so say so
+                 cgen->emit<byte>(2); cgen->emit<short>(0); branch_hint = HINT_TAKEN;
+               }
+#line 1594 "rasm.tab.cpp"
     break;
 
-  case 57:
-/* Line 1792 of yacc.c  */
-#line 121 "asm/semantics.ypp"
-    {
+  case 72: /* instruction: SYSCALL  */
+#line 162 "asm/semantics.ypp"
+                       {
                   cgen->emit<byte>(10); cgen->emit<short>(0); cgen->emit<uint32_t>(0);
                }
+#line 1602 "rasm.tab.cpp"
     break;
 
-  case 58:
-/* Line 1792 of yacc.c  */
-#line 124 "asm/semantics.ypp"
-    {
+  case 73: /* instruction: NOOP  */
+#line 165 "asm/semantics.ypp"
+                    {
                  cgen->emit<byte>(0); cgen->emit<short>(0); cgen->emit<uint32_t>(0);
                }
+#line 1610 "rasm.tab.cpp"
     break;
 
-  case 59:
-/* Line 1792 of yacc.c  */
-#line 127 "asm/semantics.ypp"
-    {
+  case 74: /* instruction: LABELREF  */
+#line 168 "asm/semantics.ypp"
+                        {
                 cout << "unknown instruction; line " << yylineno << endl;  exit(11);  
               }
+#line 1618 "rasm.tab.cpp"
     break;
 
-  case 61:
-/* Line 1792 of yacc.c  */
-#line 134 "asm/semantics.ypp"
-    {
+  case 76: /* word: WORD error  */
+#line 175 "asm/semantics.ypp"
+                          {
                  cout << "invalid .word; line " << yylineno << endl;  exit(11);             
              }
+#line 1626 "rasm.tab.cpp"
     break;
 
-  case 63:
-/* Line 1792 of yacc.c  */
-#line 140 "asm/semantics.ypp"
-    {                        
+  case 78: /* byte: BYTE error  */
+#line 181 "asm/semantics.ypp"
+                          {                        
                 cout << "invalid .byte; line " << yylineno << endl;   exit(11);            
              }
+#line 1634 "rasm.tab.cpp"
     break;
 
-  case 64:
-/* Line 1792 of yacc.c  */
-#line 145 "asm/semantics.ypp"
-    { cgen->emit_n<byte>((yyvsp[(2) - (2)].sysword), 0); }
+  case 79: /* space: SPACE INTEGER  */
+#line 186 "asm/semantics.ypp"
+                                     { cgen->emit_n<byte>((yyvsp[0].sysword), 0); }
+#line 1640 "rasm.tab.cpp"
     break;
 
-  case 65:
-/* Line 1792 of yacc.c  */
-#line 146 "asm/semantics.ypp"
-    {                       
+  case 80: /* space: SPACE error  */
+#line 187 "asm/semantics.ypp"
+                           {                       
                cout << "invalid .space; line " << yylineno << endl;   exit(11);             
              }
+#line 1648 "rasm.tab.cpp"
     break;
 
-  case 66:
-/* Line 1792 of yacc.c  */
-#line 151 "asm/semantics.ypp"
-    { cgen->emit_string(std::string((yyvsp[(2) - (2)].sysstring).ptr, (yyvsp[(2) - (2)].sysstring).len)); }
+  case 81: /* ascii: ASCII STRING  */
+#line 192 "asm/semantics.ypp"
+                                     { cgen->emit_string(std::string((yyvsp[0].sysstring).ptr, (yyvsp[0].sysstring).len)); }
+#line 1654 "rasm.tab.cpp"
     break;
 
-  case 67:
-/* Line 1792 of yacc.c  */
-#line 152 "asm/semantics.ypp"
-    {                       
+  case 82: /* ascii: ASCII error  */
+#line 193 "asm/semantics.ypp"
+                           {                       
                 cout << "invalid .ascii; line " << yylineno << endl;  exit(11);
              }
+#line 1662 "rasm.tab.cpp"
     break;
 
-  case 68:
-/* Line 1792 of yacc.c  */
-#line 157 "asm/semantics.ypp"
-    { cgen->emit_string(std::string((yyvsp[(2) - (2)].sysstring).ptr, (yyvsp[(2) - (2)].sysstring).len)); cgen->emit<byte>(0); }
+  case 83: /* asciiz: ASCIIZ STRING  */
+#line 198 "asm/semantics.ypp"
+                                      { cgen->emit_string(std::string((yyvsp[0].sysstring).ptr, (yyvsp[0].sysstring).len)); cgen->emit<byte>(0); }
+#line 1668 "rasm.tab.cpp"
     break;
 
-  case 69:
-/* Line 1792 of yacc.c  */
-#line 158 "asm/semantics.ypp"
-    {                       
+  case 84: /* asciiz: ASCIIZ error  */
+#line 199 "asm/semantics.ypp"
+                            {                       
                 cout << "invalid .asciiz; line " << yylineno << endl;  exit(11);
              }
+#line 1676 "rasm.tab.cpp"
     break;
 
-  case 70:
-/* Line 1792 of yacc.c  */
-#line 163 "asm/semantics.ypp"
-    { cgen->emit<uint32_t>((yyvsp[(1) - (1)].sysword)); }
+  case 85: /* integers: INTEGER  */
+#line 204 "asm/semantics.ypp"
+                                     { cgen->emit<uint32_t>((yyvsp[0].sysword)); }
+#line 1682 "rasm.tab.cpp"
     break;
 
-  case 71:
-/* Line 1792 of yacc.c  */
-#line 164 "asm/semantics.ypp"
-    { cgen->emit<uint32_t>((yyvsp[(2) - (2)].sysword)); }
+  case 86: /* integers: integers INTEGER  */
+#line 205 "asm/semantics.ypp"
+                                     { cgen->emit<uint32_t>((yyvsp[0].sysword)); }
+#line 1688 "rasm.tab.cpp"
     break;
 
-  case 72:
-/* Line 1792 of yacc.c  */
-#line 167 "asm/semantics.ypp"
-    { cgen->emit<byte>((yyvsp[(1) - (1)].sysword)); }
+  case 87: /* bytes: INTEGER  */
+#line 208 "asm/semantics.ypp"
+                                     { cgen->emit<byte>((yyvsp[0].sysword)); }
+#line 1694 "rasm.tab.cpp"
     break;
 
-  case 73:
-/* Line 1792 of yacc.c  */
-#line 168 "asm/semantics.ypp"
-    { cgen->emit<byte>((yyvsp[(2) - (2)].sysword)); }
+  case 88: /* bytes: bytes INTEGER  */
+#line 209 "asm/semantics.ypp"
+                                     { cgen->emit<byte>((yyvsp[0].sysword)); }
+#line 1700 "rasm.tab.cpp"
     break;
 
 
-/* Line 1792 of yacc.c  */
-#line 1812 "rasm.tab.cpp"
+#line 1704 "rasm.tab.cpp"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1822,96 +1715,58 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -1923,14 +1778,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1943,29 +1797,30 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1977,7 +1832,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1988,26 +1843,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2016,31 +1875,25 @@ yyreturn:
       yydestruct ("Cleanup: discarding lookahead",
                   yytoken, &yylval);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-/* Line 2055 of yacc.c  */
-#line 171 "asm/semantics.ypp"
+#line 212 "asm/semantics.ypp"
 
 
 
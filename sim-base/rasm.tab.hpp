@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_RASM_TAB_HPP_INCLUDED
 # define YY_YY_RASM_TAB_HPP_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 1
 #endif
@@ -40,63 +45,61 @@
 extern int yydebug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NEWLINE = 258,
-     TEXT_SECTION = 259,
-     DATA_SECTION = 260,
-     LABELDECL = 261,
-     INTEGER = 262,
-     LABELREF = 263,
-     REGISTER = 264,
-     INVALID_REGISTER = 265,
-     ADDI = 266,
-     ADD = 267,
-     SUBI = 268,
-     BRANCH = 269,
-     BRANCHEQZ = 270,
-     BRANCHGE = 271,
-     BRANCHNE = 272,
-     LOADADDR = 273,
-     LOADBYTE = 274,
-     LOADIMMED = 275,
-     SYSCALL = 276,
-     NOOP = 277,
-     WORD = 278,
-     BYTE = 279,
-     SPACE = 280,
-     ASCII = 281,
-     ASCIIZ = 282,
-     STRING = 283,
-     SECTION_IDENT = 284
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NEWLINE = 258,                 /* NEWLINE  */
+    TEXT_SECTION = 259,            /* TEXT_SECTION  */
+    DATA_SECTION = 260,            /* DATA_SECTION  */
+    LABELDECL = 261,               /* LABELDECL  */
+    INTEGER = 262,                 /* INTEGER  */
+    LABELREF = 263,                /* LABELREF  */
+    REGISTER = 264,                /* REGISTER  */
+    INVALID_REGISTER = 265,        /* INVALID_REGISTER  */
+    ADDI = 266,                    /* ADDI  */
+    ADD = 267,                     /* ADD  */
+    SUBI = 268,                    /* SUBI  */
+    BRANCH = 269,                  /* BRANCH  */
+    BRANCHEQZ = 270,               /* BRANCHEQZ  */
+    BRANCHGE = 271,                /* BRANCHGE  */
+    BRANCHNE = 272,                /* BRANCHNE  */
+    LOADADDR = 273,                /* LOADADDR  */
+    LOADBYTE = 274,                /* LOADBYTE  */
+    LOADIMMED = 275,               /* LOADIMMED  */
+    SYSCALL = 276,                 /* SYSCALL  */
+    NOOP = 277,                    /* NOOP  */
+    WORD = 278,                    /* WORD  */
+    BYTE = 279,                    /* BYTE  */
+    SPACE = 280,                   /* SPACE  */
+    ASCII = 281,                   /* ASCII  */
+    ASCIIZ = 282,                  /* ASCIIZ  */
+    STRING = 283,                  /* STRING  */
+    SECTION_IDENT = 284,           /* SECTION_IDENT  */
+    HINT_TAKEN_SUFFIX = 285,       /* HINT_TAKEN_SUFFIX  */
+    HINT_NOT_TAKEN_SUFFIX = 286,   /* HINT_NOT_TAKEN_SUFFIX  */
+    MUL = 287,                     /* MUL  */
+    DIV = 288,                     /* DIV  */
+    REM = 289,                     /* REM  */
+    LOADWORD = 290,                /* LOADWORD  */
+    STOREBYTE = 291,               /* STOREBYTE  */
+    STOREWORD = 292                /* STOREWORD  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
+/* Value type.  */
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
 extern YYSTYPE yylval;
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
 int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_YY_RASM_TAB_HPP_INCLUDED  */
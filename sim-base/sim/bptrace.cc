@@ -0,0 +1,64 @@
+#include "bptrace.h"
+#include <string.h>
+
+using namespace std;
+
+bool bptrace_writer::open(const char *filename)
+{
+	out = fopen(filename, "wb");
+	if (!out) {
+		return false;
+	}
+	fwrite(bptrace_magic, sizeof(bptrace_magic), 1, out);
+	buffer.reserve(4096);
+	return true;
+}
+
+
+void bptrace_writer::flush()
+{
+	if (out && !buffer.empty()) {
+		fwrite(&buffer[0], sizeof(trace_record), buffer.size(), out);
+	}
+	buffer.clear();
+}
+
+
+void bptrace_writer::close()
+{
+	if (out) {
+		flush();
+		fclose(out);
+		out = NULL;
+	}
+}
+
+
+bool bptrace_load(const char *filename, vector<trace_record> &records)
+{
+	FILE *in = fopen(filename, "rb");
+	if (!in) {
+		perror(filename);
+		return false;
+	}
+
+	char magic[sizeof(bptrace_magic)];
+	if (fread(magic, sizeof(magic), 1, in) != 1 || memcmp(magic, bptrace_magic, sizeof(magic))) {
+		fprintf(stderr, "%s: not a branch trace\n", filename);
+		fclose(in);
+		return false;
+	}
+
+	fseek(in, 0, SEEK_END);
+	long bytes = ftell(in) - sizeof(magic);
+	fseek(in, sizeof(magic), SEEK_SET);
+
+	records.resize(bytes / sizeof(trace_record));
+	size_t got = records.empty() ? 0 : fread(&records[0], sizeof(trace_record), records.size(), in);
+	fclose(in);
+	if (got != records.size()) {
+		fprintf(stderr, "%s: short read\n", filename);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,51 @@
+#ifndef _BPTRACE_H_
+#define _BPTRACE_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "types.h"
+
+// Branch trace file: a four byte magic followed by one record per resolved branch.
+// Instructions are 8-byte aligned, so the low three bits of the PC are free; bit 0
+// holds the outcome and bits 1-2 the static hint. The target is the taken-branch
+// address from the immediate.
+const char bptrace_magic[4] = { 'R', 'B', 'T', '1' };
+
+struct trace_record {
+	uint32_t pc_taken;
+	uint32_t target;
+
+	uint32_t pc() const { return pc_taken & ~7u; }
+	bool taken() const { return pc_taken & 1; }
+	byte hint() const { return (pc_taken >> 1) & 3; }
+};
+
+class bptrace_writer {
+	FILE *out;
+	std::vector<trace_record> buffer;
+	uint64_t count;
+
+	void flush();
+
+public:
+	bptrace_writer() : out(NULL), count(0) {}
+	~bptrace_writer() { close(); }
+
+	bool open(const char *filename);
+	void close();
+
+	void record(uint32_t pc, uint32_t target, bool taken, byte hint)
+	{
+		trace_record r = { pc | (taken ? 1u : 0u) | ((hint & 3u) << 1), target };
+		buffer.push_back(r);
+		if (buffer.size() >= 4096) flush();
+		count++;
+	}
+
+	uint64_t records() const { return count; }
+};
+
+// Reads a whole trace into memory. returns false (and prints why) on failure.
+bool bptrace_load(const char *filename, std::vector<trace_record> &records);
+
+#endif /* _BPTRACE_H_ */
@@ -0,0 +1,252 @@
+#include "cache.h"
+#include <sched.h>
+#include <algorithm>
+
+using namespace std;
+
+coherence_bus::coherence_bus(int cores, int size, int assoc, int line_bytes)
+{
+	lineBytes = line_bytes;
+	ways = assoc;
+	sets = size / (assoc * line_bytes);
+	caches.resize(cores);
+	for (int c = 0; c < cores; c++) {
+		l1_cache::line empty = { 0, LINE_INVALID, 0 };
+		caches[c].lines.assign(sets * ways, empty);
+	}
+	clocksDone.assign(cores, 0);
+	useClock = 0;
+	busReads = 0;
+	busReadXs = 0;
+	busUpgrades = 0;
+	flushes = 0;
+	transfers = 0;
+}
+
+
+void coherence_bus::wait_turn(int core, uint64_t clock)
+{
+	for (int x = 0; x < (int)clocksDone.size(); x++) {
+		uint64_t needed = x < core ? clock + 1 : clock;
+		while (x != core && __atomic_load_n(&clocksDone[x], __ATOMIC_ACQUIRE) < needed) {
+			sched_yield();
+		}
+	}
+}
+
+
+// The release pairs with wait_turn's acquire, so what the core wrote during those clocks is
+// seen by whichever core goes next.
+void coherence_bus::finish_clocks(int core, uint64_t clocks)
+{
+	__atomic_store_n(&clocksDone[core], clocks, __ATOMIC_RELEASE);
+}
+
+
+int coherence_bus::access(int core, uint32_t addr, int size, bool write)
+{
+	int clocks = 0;
+
+	// an unaligned access may straddle two lines; it waits for the slower one
+	for (uint64_t a = addr; a < (uint64_t)addr + size; ) {
+		uint32_t tag = a / lineBytes;
+		uint64_t end = min((uint64_t)addr + size, (uint64_t)(tag + 1) * lineBytes);
+		uint64_t bytes = end - a;
+		uint64_t mask = (bytes == 64 ? ~0ULL : (1ULL << bytes) - 1) << (a % lineBytes);
+		clocks = max(clocks, access_line(core, tag, mask, write));
+		a = end;
+	}
+	caches[core].stallClocks += clocks;
+	return clocks;
+}
+
+
+int coherence_bus::access_line(int core, uint32_t tag, uint64_t mask, bool write)
+{
+	l1_cache &c = caches[core];
+	l1_cache::line *l = find(core, tag);
+	int clocks = 0;
+
+	if (write) c.writes++;
+	else c.reads++;
+
+	if (l) {
+		if (write && l->state == LINE_SHARED) {
+			// BusUpgr: every other copy goes, then the write proceeds as on an exclusive line
+			busUpgrades++;
+			c.upgrades++;
+			for (int k = 0; k < (int)caches.size(); k++) {
+				if (k != core) lose(k, tag);
+			}
+			clocks = LATENCY_UPGRADE;
+		}
+		if (write) l->state = LINE_MODIFIED; // silent from exclusive
+	}
+	else {
+		// BusRd or BusRdX; every other cache snoops it
+		if (write) {
+			c.writeMisses++;
+			busReadXs++;
+		}
+		else {
+			c.readMisses++;
+			busReads++;
+		}
+		map<uint32_t, line_sharing>::iterator s = sharing.find(tag);
+		if (s != sharing.end() && s->second.lost[core]) {
+			// we had this line until another core wrote to it. If that core wrote none of the
+			// bytes we want now, only the shared line made us miss.
+			c.coherenceMisses++;
+			if (s->second.written[core] & mask) s->second.trueSharing++;
+			else s->second.falseSharing++;
+			s->second.lost[core] = false;
+		}
+
+		bool supplied = false;
+		for (int k = 0; k < (int)caches.size(); k++) {
+			l1_cache::line *o = k != core ? find(k, tag) : NULL;
+			if (!o) continue;
+			supplied = true;
+			if (o->state == LINE_MODIFIED) flushes++; // memory is updated as the owner supplies it
+			if (write) lose(k, tag);
+			else o->state = LINE_SHARED;
+		}
+		if (supplied) transfers++;
+		clocks = supplied ? LATENCY_CACHE : LATENCY_MEMORY;
+
+		l = victim(core, tag);
+		if (l->state == LINE_MODIFIED) c.writebacks++;
+		l->tag = tag;
+		l->state = write ? LINE_MODIFIED : (supplied ? LINE_SHARED : LINE_EXCLUSIVE);
+	}
+	l->lastUse = ++useClock;
+	if (write) note_write(core, tag, mask);
+	return clocks;
+}
+
+
+l1_cache::line *coherence_bus::find(int core, uint32_t tag)
+{
+	l1_cache::line *set = &caches[core].lines[(tag % sets) * ways];
+
+	for (int w = 0; w < ways; w++) {
+		if (set[w].state != LINE_INVALID && set[w].tag == tag) return &set[w];
+	}
+	return NULL;
+}
+
+
+// An invalid way if there is one, otherwise the least recently used.
+l1_cache::line *coherence_bus::victim(int core, uint32_t tag)
+{
+	l1_cache::line *set = &caches[core].lines[(tag % sets) * ways];
+	l1_cache::line *v = &set[0];
+
+	for (int w = 0; w < ways; w++) {
+		if (set[w].state == LINE_INVALID) return &set[w];
+		if (set[w].lastUse < v->lastUse) v = &set[w];
+	}
+	return v;
+}
+
+
+// Another core's write invalidates core's copy of the line, if it has one.
+void coherence_bus::lose(int core, uint32_t tag)
+{
+	l1_cache::line *l = find(core, tag);
+	if (!l) {
+		return;
+	}
+	l->state = LINE_INVALID;
+	caches[core].invalidated++;
+
+	line_sharing &s = sharing[tag];
+	if (s.lost.empty()) {
+		s.lost.resize(caches.size(), false);
+		s.written.resize(caches.size(), 0);
+	}
+	s.lost[core] = true;
+	s.written[core] = 0;
+	s.invalidations++;
+}
+
+
+// Remembers which bytes core wrote, for the cores that have lost the line.
+void coherence_bus::note_write(int core, uint32_t tag, uint64_t mask)
+{
+	map<uint32_t, line_sharing>::iterator s = sharing.find(tag);
+	if (s == sharing.end()) {
+		return;
+	}
+	for (int k = 0; k < (int)caches.size(); k++) {
+		if (k != core && s->second.lost[k]) s->second.written[k] |= mask;
+	}
+}
+
+
+static double percent(uint64_t part, uint64_t whole)
+{
+	return whole ? 100.0 * part / whole : 0.0;
+}
+
+
+void coherence_bus::display_stats(int core)
+{
+	const l1_cache &c = caches[core];
+
+	printf("stat.l1.reads: %llu\n", (unsigned long long)c.reads);
+	printf("stat.l1.writes: %llu\n", (unsigned long long)c.writes);
+	printf("stat.l1.readMisses: %llu (%.1f%%)\n", (unsigned long long)c.readMisses, percent(c.readMisses, c.reads));
+	printf("stat.l1.writeMisses: %llu (%.1f%%)\n", (unsigned long long)c.writeMisses, percent(c.writeMisses, c.writes));
+	printf("stat.l1.upgrades: %llu\n", (unsigned long long)c.upgrades);
+	printf("stat.l1.coherenceMisses: %llu\n", (unsigned long long)c.coherenceMisses);
+	printf("stat.l1.invalidated: %llu\n", (unsigned long long)c.invalidated);
+	printf("stat.l1.writebacks: %llu\n", (unsigned long long)c.writebacks);
+	printf("stat.l1.stallClocks: %llu\n", (unsigned long long)c.stallClocks);
+}
+
+
+static bool contended(const pair<uint32_t, const line_sharing *> &a, const pair<uint32_t, const line_sharing *> &b)
+{
+	if (a.second->invalidations != b.second->invalidations) return a.second->invalidations > b.second->invalidations;
+	return a.first < b.first;
+}
+
+
+void coherence_bus::display_bus_stats()
+{
+	uint64_t invalidations = 0, trueSharing = 0, falseSharing = 0;
+	vector<pair<uint32_t, const line_sharing *> > sorted;
+
+	for (map<uint32_t, line_sharing>::const_iterator i = sharing.begin(); i != sharing.end(); ++i) {
+		invalidations += i->second.invalidations;
+		trueSharing += i->second.trueSharing;
+		falseSharing += i->second.falseSharing;
+		sorted.push_back(make_pair(i->first, &i->second));
+	}
+	printf("stat.l1: %d bytes, %d way, %d byte lines per core\n", sets * ways * lineBytes, ways, lineBytes);
+	printf("stat.bus.transactions: %llu\n", (unsigned long long)(busReads + busReadXs + busUpgrades));
+	printf("stat.bus.reads: %llu\n", (unsigned long long)busReads);
+	printf("stat.bus.readExclusives: %llu\n", (unsigned long long)busReadXs);
+	printf("stat.bus.upgrades: %llu\n", (unsigned long long)busUpgrades);
+	printf("stat.bus.cacheTransfers: %llu\n", (unsigned long long)transfers);
+	printf("stat.bus.flushes: %llu\n", (unsigned long long)flushes);
+	printf("stat.bus.invalidations: %llu\n", (unsigned long long)invalidations);
+	printf("stat.bus.trueSharingMisses: %llu\n", (unsigned long long)trueSharing);
+	printf("stat.bus.falseSharingMisses: %llu\n", (unsigned long long)falseSharing);
+	if (sorted.empty()) {
+		return;
+	}
+
+	// the lines bouncing between cores the most
+	sort(sorted.begin(), sorted.end(), contended);
+	if (sorted.size() > 10) sorted.resize(10);
+	printf("-=-=-=-=-=-=-=Most contended cache lines-=-=-=-=-=-=-=\n");
+	printf("      line  invalidations  true sharing  false sharing\n");
+	for (size_t x = 0; x < sorted.size(); x++) {
+		const line_sharing &s = *sorted[x].second;
+		printf("0x%08x  %13llu  %12llu  %13llu\n", sorted[x].first * lineBytes
+		      , (unsigned long long)s.invalidations, (unsigned long long)s.trueSharing, (unsigned long long)s.falseSharing);
+	}
+	printf("-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=\n");
+}
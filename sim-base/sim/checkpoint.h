@@ -0,0 +1,38 @@
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+#include <stdio.h>
+#include "cpu.h"
+
+// One pass over a checkpoint file, writing or reading. The state is moved field by field by one
+// transfer() per type that serves both directions, so what is saved and what is restored
+// cannot drift apart.
+struct checkpoint_io {
+	FILE *file;
+	bool  saving;
+	bool  ok;       // false once a read or write has come up short
+
+	template <class T>
+	void raw(T &value)
+	{
+		if (!ok) return;
+		if (saving) ok = fwrite(&value, sizeof(T), 1, file) == 1;
+		else ok = fread(&value, sizeof(T), 1, file) == 1;
+	}
+};
+
+// -K: writes the state of a five stage core stopped at -x to path. That is the registers and
+// their locks, every latch and queue of the pipeline, the predictor tables, the counters and
+// the pages of m written since the program was loaded (m must track its writes). False, with
+// the reason printed, if the file cannot be written.
+bool save_checkpoint(const char *path, const cpu_options &opts, cpu_core &core, memory *m);
+
+// -r: opens a checkpoint and reads the pipeline options it was taken with (-b, -H, -e, -f, -Q,
+// -F and -l) into opts, for setting the core up. NULL, with the reason printed, if path is not
+// a checkpoint.
+FILE *open_checkpoint(const char *path, cpu_options &opts);
+
+// Reads the rest of the checkpoint into a core set up with those options and into m, then
+// closes f. False, with the reason printed, if the file is cut short.
+bool restore_checkpoint(FILE *f, const char *path, cpu_core &core, memory *m);
+
+#endif /* _CHECKPOINT_H_ */
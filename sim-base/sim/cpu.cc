@@ -1,7 +1,20 @@
 #include <stdio.h>
 #include "cpu.h"
 #include "memory.h"
+#include "superscalar.h"
+#include "ooo.h"
+#include "lanes.h"
+#include "checkpoint.h"
+#include "placement.h"
 #include <unistd.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <new>
+#include <string>
 
 // Some minimal state display. If I had the time, I'd do a quick gui app, which is more natural
 // understanding what is going on under the covers.
@@ -72,72 +85,635 @@ static void print_stages(cpu_core *core)
 }
 
 
-// Actual execution of whatever is in the CPU will occur here.
-void run_cpu(memory *mem, const bool verbose_cpu, const int branchPredictorInput)
-{
+struct core_pool;
+
+// One simulated core, the model running it and the reports it feeds.
+struct core_context {
 	cpu_core core;
+	branch_profile profile;
+	load_use_profile loadUse;
+	bptrace_writer trace;
+	ooo_pipeline *ooo;
+	superscalar_pipeline *wide;
+	const char *fault;     // what stopped the core early, NULL if it exited
+	core_pool *pool;       // -n: the cores it runs alongside
+	char  *consoleBuffer;  // -n: syscall output since the last barrier
+	size_t consoleSize;
+	double busySeconds;    // -n: host time spent clocking the core, barriers left out
+	bool   job;            // start_job: a job is open
+	cpu_options opts;      // start_job: the open job's options
+
+	core_context() : ooo(NULL), wide(NULL), fault(NULL), pool(NULL), consoleBuffer(NULL), consoleSize(0), busySeconds(0), job(false) {}
+};
+
+
+// Sets a core up to run from the start of .text. False if a report file cannot be opened.
+static bool start_core(core_context &c, memory *mem, coherence_bus *caches, const cpu_options &opts, int id)
+{
+	cpu_core &core = c.core;
 
 	core.cycles=0;
 	core.BPHits=0; 
 	core.BPMisses=0; 
 	core.PC = text_segment;
 	core.usermode = true;
+	core.coreId = id;
+	core.coreCount = opts.cores;
+	core.console = stdout;
+	core.input = stdin;
 	core.mem = mem;
-	core.verbose = verbose_cpu;
-	core.branchPredictor = branchPredictorInput; // taking a variable in to determine which branch predictor to use
+	core.caches = caches;
+	core.verbose = opts.verbose;
+	core.branchPredictor = opts.branchPredictor; // taking a variable in to determine which branch predictor to use
+	core.hintOverride = opts.hintOverride;
+	core.hintOverrides = 0;
+	core.earlyBranch = opts.earlyBranch;
+	core.branchFlushCycles = 0;
+	core.earlyBranchStalls = 0;
+	core.earlyBranchForwards = 0;
+	core.loadUseStalls = 0;
+	core.fusion = opts.fusion;
+	core.fusedPairs = 0;
+	core.syscallsInFlight = 0;
+	if (opts.profileTop >= 0 || opts.profileCsv) {
+		core.profile = &c.profile;
+	}
+	if (opts.loadUseTop >= 0) {
+		core.loadUse = &c.loadUse;
+	}
+	if (opts.iqDepth) {
+		core.ifs.SetQueues(opts.ftqDepth ? opts.ftqDepth : opts.iqDepth, opts.iqDepth);
+	}
+	if (opts.loopBuffer) {
+		core.ifs.SetLoopBuffer(opts.loopBuffer);
+	}
+	// first, so that failing leaves nothing for finish_core to free
+	if (opts.traceFile) {
+		if (!c.trace.open(opts.traceFile)) {
+			perror(opts.traceFile);
+			return false;
+		}
+		core.trace = &c.trace;
+	}
+	for (size_t x = 0; x < opts.shadowPredictors.size(); x++) {
+		shadow_predictor sp = { opts.shadowPredictors[x], make_predictor(opts.shadowPredictors[x]), 0, 0 };
+		core.shadows.push_back(sp);
+	}
 
 	// initialize registers
 	//for (int32_t x = 0; x < 32; x++) core.registers[x] = 0;
 
-	// start the cpu loop
-	try {
-		while (core.usermode) {
-			// Execute the stages
-			//core.mys.Execute();
-			core.wbs.Execute(); // First so that writes happen before reads
-			core.mys.Execute();
-			core.ifs.Execute();
-			core.ids.Execute();
-			core.exs.Execute();
-
-			// Do Forwarding
-			core.exs.DoForwarding();
-			core.mys.DoForwarding();
-
-			// Print the intermediate stages onto the screen for debugging.
-			if (core.verbose) {
-				print_stages(&core);
-			}
+	// -o and -w swap the five stages for another model; everything else is shared
+	c.ooo = opts.robSize ? new ooo_pipeline(&core, opts) : NULL;
+	c.wide = ((opts.width || opts.depth || opts.smtImage) && !c.ooo) ? new superscalar_pipeline(&core, opts) : NULL;
+	return true;
+}
+
+
+// False once the core has exited or used up its -x clocks.
+static bool running(const core_context &c, const cpu_options &opts)
+{
+	return c.core.usermode && (!opts.maxCycles || c.core.cycles < opts.maxCycles);
+}
+
 
-			// shift the latches
-			//core.ids.Shift();
-			//core.exs.Shift();
-			//core.mys.Shift();
-			core.wbs.Shift();
-			core.mys.Shift();
-			core.exs.Shift();
-			core.ids.Shift();
-			core.cycles++;
+// Actual execution of whatever is in the CPU will occur here, one clock per call.
+static void clock_core(core_context &c)
+{
+	cpu_core &core = c.core;
+
+	if (c.ooo) {
+		c.ooo->cycle();
+		core.cycles++;
+		return;
+	}
+	if (c.wide) {
+		c.wide->cycle();
+		core.cycles++;
+		return;
+	}
+
+	// Execute the stages
+	//core.mys.Execute();
+	core.wbs.Execute(); // First so that writes happen before reads
+	core.mys.Execute();
+	core.ifs.Execute();
+	core.ids.Execute();
+	core.exs.Execute();
+
+	// Do Forwarding
+	core.exs.DoForwarding();
+	core.mys.DoForwarding();
+
+	// Print the intermediate stages onto the screen for debugging.
+	if (core.verbose) {
+		print_stages(&core);
+	}
+
+	// shift the latches
+	//core.ids.Shift();
+	//core.exs.Shift();
+	//core.mys.Shift();
+	core.wbs.Shift();
+	core.mys.Shift();
+	core.exs.Shift();
+	core.ids.Shift();
+	core.cycles++;
 #if 0
-			// Occasionally this stuff is useful
-			if (core.verbose) {
-				for (int32_t x = 0; x < 8; x++) {
-					printf("$%d:\t0x%08x\t\t$%d:\t0x%08x\t\t$%d:\t0x%08x\t\t$%d:\t0x%08x\n"
-					      , x, core.registers[x]
-					      , x + 8, core.registers[x + 8]
-					      , x + 16, core.registers[x + 16]
-					      , x + 24, core.registers[x + 24]);
+	// Occasionally this stuff is useful
+	if (core.verbose) {
+		for (int32_t x = 0; x < 8; x++) {
+			printf("$%d:\t0x%08x\t\t$%d:\t0x%08x\t\t$%d:\t0x%08x\t\t$%d:\t0x%08x\n"
+			      , x, core.registers[x]
+			      , x + 8, core.registers[x + 8]
+			      , x + 16, core.registers[x + 16]
+			      , x + 24, core.registers[x + 24]);
+		}
+		//getchar(); // slows things down!
+	}
+#endif
+}
+
+
+static void display_core_stats(core_context &c, const cpu_options &opts)
+{
+	cpu_core &core = c.core;
+
+	printf("stat.processorCycles: %d\n", core.cycles);
+	printf("stat.BPHits: %d\n", core.BPHits);
+	printf("stat.BPMisses: %d\n", core.BPMisses);
+	printf("stat.branchFlushCycles: %d\n", core.branchFlushCycles);
+	if (core.earlyBranch) {
+		printf("stat.earlyBranchStalls: %d\n", core.earlyBranchStalls);
+		printf("stat.earlyBranchForwards: %d\n", core.earlyBranchForwards);
+	}
+	if (core.hintOverride) printf("stat.hintOverrides: %d\n", core.hintOverrides);
+	if (!c.wide && !c.ooo) printf("stat.loadUseStalls: %d\n", core.loadUseStalls);
+	if (!c.wide && !c.ooo && core.fusion) {
+		// each pair went down the pipeline in one slot instead of two
+		uint32_t branches = core.BPHits + core.BPMisses;
+		printf("stat.fusedPairs: %d (%.1f%% of branches)\n", core.fusedPairs, branches ? 100.0 * core.fusedPairs / branches : 0.0);
+		printf("stat.fusionSlotsSaved: %d\n", core.fusedPairs);
+	}
+	if (!c.wide && !c.ooo && (opts.iqDepth || opts.loopBuffer)) core.ifs.DisplayFetchStats();
+	if (c.wide) c.wide->display_stats();
+	if (c.ooo) c.ooo->display_stats();
+	if (core.caches) core.caches->display_stats(core.coreId);
+	for (size_t x = 0; x < core.shadows.size(); x++) {
+		printf("stat.shadow[%d].BPHits: %d\n", core.shadows[x].kind, core.shadows[x].BPHits);
+		printf("stat.shadow[%d].BPMisses: %d\n", core.shadows[x].kind, core.shadows[x].BPMisses);
+	}
+	//printf("BP miss rate: %f\n",(double)core.BPMisses/ (double)(core.BPHits+core.BPMisses));
+}
+
+
+// Reports that are still useful after a fault, then cleanup.
+static void finish_core(core_context &c, const cpu_options &opts)
+{
+	if (opts.profileTop >= 0) {
+		c.profile.display(stdout, opts.profileTop);
+	}
+	if (opts.loadUseTop >= 0) {
+		c.loadUse.display(stdout, opts.loadUseTop);
+	}
+	if (opts.profileCsv && !c.profile.write_csv(opts.profileCsv)) {
+		perror(opts.profileCsv);
+	}
+	if (c.core.trace) {
+		c.trace.close();
+		printf("stat.traceRecords: %llu\n", (unsigned long long)c.trace.records());
+	}
+	for (size_t x = 0; x < c.core.shadows.size(); x++) {
+		delete c.core.shadows[x].model;
+	}
+	delete c.wide;
+	delete c.ooo;
+}
+
+
+// -n: each core runs quantum clocks on its own host thread, then all of them meet at a
+// barrier. Between the two barriers the main thread writes out what the cores printed, in
+// core order, so the output does not depend on how the host scheduled the threads.
+//
+// With -c the cores share a bus, and whichever host thread got there first would win it. Each
+// thread tells the bus how many clocks its core has finished, and the bus holds a core's
+// accesses back until it is that core's turn, so they happen in (clock, core) order on every run.
+struct core_pool {
+	std::vector<core_context *> cores;
+	memory *mem;
+	coherence_bus *caches;
+	uint32_t quantum;
+	const cpu_options *opts;
+	pthread_barrier_t start, end;
+	bool done;
+};
+
+// What a core thread is handed: its pool and its core's number.
+struct core_slot {
+	core_pool *pool;
+	int id;
+};
+
+
+// Each thread sets its own core up, after any -a pinning, so the core's state is allocated on
+// the thread's node. The first barrier waits for all of them.
+static void *core_thread(void *arg)
+{
+	core_slot &slot = *(core_slot *)arg;
+	core_pool &pool = *slot.pool;
+	const cpu_options &opts = *pool.opts;
+	core_context *core = new core_context;
+	core_context &c = *core;
+	timespec begin, finish;
+
+	if (!opts.hostCpus.empty()) {
+		pin_thread(opts.hostCpus[slot.id % opts.hostCpus.size()]);
+	}
+	start_core(c, pool.mem, pool.caches, opts, slot.id);
+	c.pool = &pool;
+	c.core.console = open_memstream(&c.consoleBuffer, &c.consoleSize);
+	if (pool.caches) pool.caches->finish_clocks(slot.id, c.core.cycles);
+	pool.cores[slot.id] = core;
+
+	for (;;) {
+		pthread_barrier_wait(&pool.start);
+		if (pool.done) {
+			break;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &begin);
+		for (uint32_t n = 0; n < pool.quantum && running(c, opts); n++) {
+			try {
+				clock_core(c);
+			} catch (const char *e) {
+				c.fault = e;
+				c.core.usermode = false;
+			}
+			// a fault or exit ends the core's turns along with the core
+			if (pool.caches) pool.caches->finish_clocks(slot.id, running(c, opts) ? c.core.cycles : ~0ULL);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &finish);
+		c.busySeconds += (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+		pthread_barrier_wait(&pool.end);
+	}
+	return NULL;
+}
+
+
+static void flush_console(core_context &c)
+{
+	fclose(c.core.console);
+	fwrite(c.consoleBuffer, 1, c.consoleSize, stdout);
+	free(c.consoleBuffer);
+	c.core.console = open_memstream(&c.consoleBuffer, &c.consoleSize);
+}
+
+
+static void run_cores(memory *mem, const cpu_options &opts)
+{
+	core_pool pool;
+	std::vector<pthread_t> threads(opts.cores);
+	std::vector<core_slot> slots(opts.cores);
+	coherence_bus *caches = opts.cacheSize ? new coherence_bus(opts.cores, opts.cacheSize, opts.cacheAssoc, opts.cacheLine) : NULL;
+	timespec begin, finish;
+
+	pool.cores.resize(opts.cores);
+	pool.mem = mem;
+	pool.caches = caches;
+	pool.quantum = opts.quantum;
+	pool.opts = &opts;
+	pool.done = false;
+	// the main thread takes part in both barriers
+	pthread_barrier_init(&pool.start, NULL, opts.cores + 1);
+	pthread_barrier_init(&pool.end, NULL, opts.cores + 1);
+
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	for (int x = 0; x < opts.cores; x++) {
+		slots[x].pool = &pool;
+		slots[x].id = x;
+		pthread_create(&threads[x], NULL, core_thread, &slots[x]);
+	}
+	uint64_t quanta = 0;
+	while (!pool.done) {
+		pthread_barrier_wait(&pool.start);
+		pthread_barrier_wait(&pool.end);
+		quanta++;
+		pool.done = true;
+		for (int x = 0; x < opts.cores; x++) {
+			flush_console(*pool.cores[x]);
+			if (running(*pool.cores[x], opts)) pool.done = false;
+		}
+	}
+	pthread_barrier_wait(&pool.start); // lets the threads see done
+	for (int x = 0; x < opts.cores; x++) {
+		pthread_join(threads[x], NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	pthread_barrier_destroy(&pool.start);
+	pthread_barrier_destroy(&pool.end);
+
+	uint64_t clocks = 0, longest = 0;
+	for (int x = 0; x < opts.cores; x++) {
+		core_context *c = pool.cores[x];
+
+		printf("stat.core: %d\n", x);
+		if (c->fault) printf("CPU fault: %s\n", c->fault);
+		else {
+			if (c->core.usermode) printf("CPU stopped at the -x limit of %u clocks\n", opts.maxCycles);
+			display_core_stats(*c, opts);
+		}
+		if (!opts.hostCpus.empty()) {
+			int cpu = opts.hostCpus[x % opts.hostCpus.size()];
+			printf("stat.hostCpu: %d (node %d)\n", cpu, cpu_node(cpu));
+		}
+		printf("stat.coreClocksPerSecond: %.0f\n", c->busySeconds > 0 ? c->core.cycles / c->busySeconds : 0.0);
+		finish_core(*c, opts);
+		clocks += c->core.cycles;
+		if (c->core.cycles > longest) longest = c->core.cycles;
+		fclose(c->core.console);
+		free(c->consoleBuffer);
+		delete c;
+	}
+	double seconds = (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+	printf("stat.cores: %d (quantum %u)\n", opts.cores, opts.quantum);
+	printf("stat.quanta: %llu\n", (unsigned long long)quanta);
+	printf("stat.processorCycles: %llu\n", (unsigned long long)longest);
+	printf("stat.hostSeconds: %.3f\n", seconds);
+	printf("stat.simulatedClocksPerSecond: %.0f\n", seconds > 0 ? clocks / seconds : 0.0);
+	if (caches) caches->display_bus_stats();
+	delete caches;
+}
+
+
+// A forked child takes over the warmed core with its what-if's settings.
+static void apply_what_if(core_context &c, const cpu_options &opts, const what_if &w, cpu_options &run)
+{
+	cpu_core &core = c.core;
+
+	run.branchPredictor = w.branchPredictor;
+	run.hintOverride = w.hintOverride;
+	run.cacheSize = w.cacheSize;
+	run.cacheAssoc = w.cacheAssoc;
+	run.cacheLine = w.cacheLine;
+	run.inputFile = w.inputFile;
+	run.maxCycles = w.maxCycles;
+	core.branchPredictor = w.branchPredictor;
+	core.hintOverride = w.hintOverride;
+	if (w.cacheSize != opts.cacheSize || w.cacheAssoc != opts.cacheAssoc || w.cacheLine != opts.cacheLine) {
+		core.caches = new coherence_bus(1, w.cacheSize, w.cacheAssoc, w.cacheLine);
+	}
+	if (w.inputFile) {
+		core.input = fopen(w.inputFile, "r"); // its presence was checked before the run
+	}
+}
+
+
+// -y: forks one child per -Y from the warmed core. Memory is private, so the parent and the
+// children share every page until one of them writes to it. A child's stdout is a pipe back
+// here, and once all of them are done the parent prints their reports in -Y order. Returns
+// true in a child, with run set to its what-if, and false in the parent.
+static bool fork_what_ifs(core_context &c, const cpu_options &opts, cpu_options &run)
+{
+	std::vector<pid_t> pids;
+	std::vector<int> pipes;
+
+	printf("stat.forkCycle: %u\n", c.core.cycles);
+	fflush(stdout); // or every child prints it again
+	for (size_t x = 0; x < opts.whatIfs.size(); x++) {
+		int fd[2];
+		if (pipe(fd) != 0) {
+			perror("pipe");
+			break;
+		}
+		pid_t pid = fork();
+		if (pid < 0) {
+			perror("fork");
+			close(fd[0]);
+			close(fd[1]);
+			break;
+		}
+		if (pid == 0) {
+			for (size_t y = 0; y < pipes.size(); y++) {
+				close(pipes[y]);
+			}
+			close(fd[0]);
+			dup2(fd[1], STDOUT_FILENO);
+			close(fd[1]);
+			if (!opts.hostCpus.empty()) {
+				pin_thread(opts.hostCpus[x % opts.hostCpus.size()]);
+			}
+			apply_what_if(c, opts, opts.whatIfs[x], run);
+			return true;
+		}
+		close(fd[1]);
+		pids.push_back(pid);
+		pipes.push_back(fd[0]);
+	}
+
+	// drain every pipe as it fills; a child blocked on a full one would never finish
+	std::vector<std::string> reports(pipes.size());
+	std::vector<pollfd> waiting(pipes.size());
+	size_t left = pipes.size();
+	for (size_t x = 0; x < pipes.size(); x++) {
+		waiting[x].fd = pipes[x];
+		waiting[x].events = POLLIN;
+	}
+	while (left) {
+		if (poll(&waiting[0], waiting.size(), -1) < 0) {
+			continue;
+		}
+		for (size_t x = 0; x < waiting.size(); x++) {
+			if (waiting[x].fd < 0 || !waiting[x].revents) {
+				continue;
+			}
+			char buffer[4096];
+			ssize_t got = read(waiting[x].fd, buffer, sizeof(buffer));
+			if (got > 0) {
+				reports[x].append(buffer, got);
+			}
+			else if (got == 0 || errno != EINTR) {
+				close(waiting[x].fd);
+				waiting[x].fd = -1;
+				left--;
+			}
+		}
+	}
+
+	for (size_t x = 0; x < pids.size(); x++) {
+		int status = 0;
+		waitpid(pids[x], &status, 0);
+		printf("stat.whatIf: %d (%s)\n", (int)x, opts.whatIfs[x].label);
+		fwrite(reports[x].data(), 1, reports[x].size(), stdout);
+		if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+			printf("what-if %d did not finish (wait status %d)\n", (int)x, status);
+		}
+	}
+	printf("stat.whatIfs: %d\n", (int)pids.size());
+	return false;
+}
+
+
+void run_cpu(memory *mem, const cpu_options &opts)
+{
+	// -a: the main thread takes the first CPU; -n cores and -y children pin themselves
+	if (!opts.hostCpus.empty()) {
+		pin_thread(opts.hostCpus[0]);
+	}
+	if (!opts.laneImages.empty()) {
+		lockstep_lanes lanes(opts.laneImages, opts);
+		lanes.run();
+		lanes.display_stats();
+		return;
+	}
+	if (opts.cores > 1) {
+		run_cores(mem, opts);
+		return;
+	}
+
+	core_context c;
+	cpu_options run = opts; // a forked child carries on with its what-if's settings, -r with the checkpoint's
+	FILE *checkpoint = NULL;
+	timespec begin, restored;
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	if (opts.restoreFile && !(checkpoint = open_checkpoint(opts.restoreFile, run))) {
+		return;
+	}
+	coherence_bus *caches = opts.cacheSize ? new coherence_bus(1, opts.cacheSize, opts.cacheAssoc, opts.cacheLine) : NULL;
+	if (!start_core(c, mem, caches, run, 0)) {
+		if (checkpoint) fclose(checkpoint);
+		delete caches;
+		return;
+	}
+	if (checkpoint && !restore_checkpoint(checkpoint, opts.restoreFile, c.core, mem)) {
+		finish_core(c, run);
+		delete caches;
+		return;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &restored);
+
+	bool child = false;
+
+	// start the cpu loop
+	try {
+		while (running(c, run)) {
+			if (opts.forkAt && c.core.cycles == opts.forkAt && !child) {
+				if (!fork_what_ifs(c, opts, run)) {
+					// the children have reported; the parent's own run ends here, without reports
+					run.profileTop = -1;
+					run.loadUseTop = -1;
+					finish_core(c, run);
+					delete caches;
+					return;
 				}
-				//getchar(); // slows things down!
+				child = true;
 			}
-#endif
+			clock_core(c);
+		}
+		if (c.core.usermode) printf("CPU stopped at the -x limit of %u clocks\n", run.maxCycles);
+		if (opts.checkpointFile) {
+			if (!c.core.usermode) printf("CPU exited before the -x limit; no checkpoint written\n");
+			else if (save_checkpoint(opts.checkpointFile, run, c.core, mem)) {
+				printf("stat.checkpointPages: %u\n", (unsigned)mem->written_pages().size());
+			}
+		}
+		if (opts.restoreFile) {
+			// from reading the checkpoint to the first clock; the pages come in as they are touched
+			printf("stat.restoreSeconds: %.6f\n", (restored.tv_sec - begin.tv_sec) + (restored.tv_nsec - begin.tv_nsec) / 1e9);
 		}
-		printf("stat.processorCycles: %d\n", core.cycles);
-		printf("stat.BPHits: %d\n", core.BPHits);
-		printf("stat.BPMisses: %d\n", core.BPMisses);
-		//printf("BP miss rate: %f\n",(double)core.BPMisses/ (double)(core.BPHits+core.BPMisses));
+		if (opts.forkAt && !child) printf("CPU never reached the -y fork at clock %u\n", opts.forkAt);
+		display_core_stats(c, run);
+		if (c.core.caches) c.core.caches->display_bus_stats();
 	} catch (const char *e) {
 		printf("CPU fault: %s\n", e);
 	}
-	
+
+	// the profile is still useful after a fault, so report it either way
+	finish_core(c, run);
+	if (c.core.caches != caches) delete c.core.caches;
+	delete caches;
+	if (child) {
+		fflush(stdout);
+		_exit(0);
+	}
+}
+
+
+core_context *new_core_context()
+{
+	return new core_context;
+}
+
+
+void delete_core_context(core_context *c)
+{
+	end_job(c);
+	delete c;
+}
+
+
+void start_job(core_context *c, memory *m, const cpu_options &opts, FILE *input, FILE *console)
+{
+	end_job(c);
+
+	// a clean core in the same storage; the stages keep pointers back to their cpu_core, so
+	// it is rebuilt in place rather than assigned
+	c->~core_context();
+	new (c) core_context;
+
+	coherence_bus *caches = opts.cacheSize ? new coherence_bus(1, opts.cacheSize, opts.cacheAssoc, opts.cacheLine) : NULL;
+	c->opts = opts;
+	c->job = true;
+	start_core(*c, m, caches, c->opts, 0);
+	c->core.input = input;
+	c->core.console = console;
+}
+
+
+bool step_job(core_context *c, uint32_t clocks, run_result &r)
+{
+	uint64_t until = (uint64_t)c->core.cycles + clocks;
+
+	if (c->job && !c->fault) {
+		try {
+			while (running(*c, c->opts) && (!clocks || c->core.cycles < until)) {
+				clock_core(*c);
+			}
+		} catch (const char *e) {
+			c->fault = e;
+		}
+	}
+	if (c->fault) r.status = c->fault;
+	else if (!c->core.usermode) r.status = "exit";
+	else if (!running(*c, c->opts)) r.status = "limit";
+	else r.status = NULL;
+	r.cycles = c->core.cycles;
+	r.BPHits = c->core.BPHits;
+	r.BPMisses = c->core.BPMisses;
+	r.branchFlushCycles = c->core.branchFlushCycles;
+	return r.status == NULL;
+}
+
+
+void end_job(core_context *c)
+{
+	if (!c->job) {
+		return;
+	}
+	finish_core(*c, c->opts);
+	delete c->core.caches;
+	c->core.caches = NULL;
+	c->job = false;
+}
+
+
+const cpu_core &job_core(const core_context *c)
+{
+	return c->core;
+}
+
+
+void run_job(core_context *c, memory *m, const cpu_options &opts, FILE *input, FILE *console, run_result &r)
+{
+	start_job(c, m, opts, input, console);
+	step_job(c, 0, r);
+	end_job(c);
 }
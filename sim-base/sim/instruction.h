@@ -6,6 +6,20 @@ class cpu_core;
 typedef void (*operation)(cpu_core *cpu);
 void sysc_op(cpu_core *cpu);
 
+// Functional units. An instruction's latency is its exe_cycles; the interval is how many
+// clocks its unit stays busy before accepting the next one (1: fully pipelined).
+enum { FU_ALU = 0, FU_MUL, FU_DIV, FU_COUNT };
+
+typedef struct _functional_unit {
+	char name[4];
+	byte interval;
+} functional_unit;
+
+const functional_unit functional_units[FU_COUNT] =
+  {{ "alu",  1 }     // one per ALU port
+  ,{ "mul",  1 }     // pipelined multiplier
+  ,{ "div", 12 } };  // blocking divider, shared by div and rem
+
 // Information about each instruction in the cpu, including function pointer and a
 // character description for debugging purposes.
 typedef struct _instruction {
@@ -24,20 +38,38 @@ typedef struct _instruction {
 	const byte mem_read;
 	const bool mem_to_register;
 	const byte exe_cycles;
+	const byte unit;           // FU_*: the functional unit executing it
 } instruction;
 
 // opcode is the instruction's position in the array.
 const instruction instructions[] =
-  {{ "    nop", NULL,     false, 0, 0, false, 0, 0, false, 1 }     // 00
-  ,{ "   addi", NULL,     true,  1, 1, false, 0, 0, false, 1 }     // 01
-  ,{ "   beqz", NULL,     false, 0, 0, true,  0, 0, false, 1 }     // 02
-  ,{ "    bge", NULL,     false, 0, 0, true,  0, 0, false, 1 }     // 03
-  ,{ "    bne", NULL,     false, 0, 0, true,  0, 0, false, 1 }     // 04
-  ,{ "     la", NULL,     true,  0, 1, false, 0, 0, false, 1 }     // 05
-  ,{ "     lb", NULL,     true,  0, 2, false, 0, 1, true , 1 }     // 06
-  ,{ "     li", NULL,     true,  0, 1, false, 0, 0, false, 1 }     // 07
-  ,{ "   subi", NULL,     true,  2, 1, false, 0, 0, false, 1 }     // 08
-  ,{ "    add", NULL,     true,  1, 0, false, 0, 0, false, 1 }     // 09
-  ,{ "syscall", &sysc_op, false, 0, 0, false, 0, 0, false, 1 } };  // 0a
+  {{ "    nop", NULL,     false, 0, 0, false, 0, 0, false, 1,  FU_ALU }     // 00
+  ,{ "   addi", NULL,     true,  1, 1, false, 0, 0, false, 1,  FU_ALU }     // 01
+  ,{ "   beqz", NULL,     false, 0, 0, true,  0, 0, false, 1,  FU_ALU }     // 02
+  ,{ "    bge", NULL,     false, 0, 0, true,  0, 0, false, 1,  FU_ALU }     // 03
+  ,{ "    bne", NULL,     false, 0, 0, true,  0, 0, false, 1,  FU_ALU }     // 04
+  ,{ "     la", NULL,     true,  0, 1, false, 0, 0, false, 1,  FU_ALU }     // 05
+  ,{ "     lb", NULL,     true,  0, 2, false, 0, 1, true , 1,  FU_ALU }     // 06
+  ,{ "     li", NULL,     true,  0, 1, false, 0, 0, false, 1,  FU_ALU }     // 07
+  ,{ "   subi", NULL,     true,  2, 1, false, 0, 0, false, 1,  FU_ALU }     // 08
+  ,{ "    add", NULL,     true,  1, 0, false, 0, 0, false, 1,  FU_ALU }     // 09
+  ,{ "syscall", &sysc_op, false, 0, 0, false, 0, 0, false, 1,  FU_ALU }     // 0a
+  ,{ "    mul", NULL,     true,  3, 0, false, 0, 0, false, 3,  FU_MUL }     // 0b
+  ,{ "    div", NULL,     true,  4, 0, false, 0, 0, false, 12, FU_DIV }     // 0c
+  ,{ "    rem", NULL,     true,  5, 0, false, 0, 0, false, 12, FU_DIV }     // 0d
+  ,{ "     sb", NULL,     false, 0, 2, false, 1, 0, false, 1,  FU_ALU }     // 0e
+  ,{ "     sw", NULL,     false, 0, 2, false, 4, 0, false, 1,  FU_ALU }     // 0f
+  ,{ "     lw", NULL,     true,  0, 2, false, 0, 4, true , 1,  FU_ALU } };  // 10
+
+// Opcodes from this one up are not instructions.
+const unsigned opcode_count = sizeof(instructions) / sizeof(instructions[0]);
+
+// Condition of each branch opcode: beqz, bge and bne.
+inline bool branch_condition(byte opcode, int32_t src1, int32_t src2)
+{
+	return (opcode == 2 && src1 == 0) ||
+	       (opcode == 3 && src1 >= src2) ||
+	       (opcode == 4 && src1 != src2);
+}
 
 #endif /* _INSTRUCTION_H_ */
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef _LANES_H_
+#define _LANES_H_
+#include <stdio.h>
+#include <vector>
+#include "cpu.h"
+
+const int MAX_LANES = 16;
+
+// One register across every lane. GCC lays the arithmetic on these out as SIMD instructions:
+// two AVX2 operations per vector, or four SSE2 ones on hosts without AVX2.
+typedef uint32_t lane_vector  __attribute__((vector_size(MAX_LANES * sizeof(uint32_t))));
+typedef int32_t  lane_svector __attribute__((vector_size(MAX_LANES * sizeof(int32_t))));
+
+// The functional lockstep model (-D): up to MAX_LANES copies of one program, each with its own
+// memory, executed one instruction for all lanes at a time. The registers are a structure of
+// arrays, regs[r][lane], so an ALU op is one vector operation across the lanes. There is no
+// pipeline and no timing.
+//
+// Lanes split when a branch goes different ways in them. Each step runs the instruction at the
+// lowest PC any lane is waiting at, masked to the lanes that are there, so the lanes that fell
+// behind catch up and the others wait for them where the paths join again.
+class lockstep_lanes {
+public:
+	lockstep_lanes(const std::vector<memory *> &images, const cpu_options &opts);
+	~lockstep_lanes();
+
+	void run();
+	void display_stats();
+
+private:
+	int lanes;
+	std::vector<memory *> images;  // by lane; .text is the same in all of them
+	uint32_t maxSteps;             // -x (0: until every lane exits)
+
+	lane_vector regs[32];
+	uint32_t PC[MAX_LANES];
+	bool     running[MAX_LANES];
+	const char *fault[MAX_LANES];  // what stopped the lane early, NULL if it exited
+	FILE    *console[MAX_LANES];   // what the lane prints, written out after the run
+	char    *consoleBuffer[MAX_LANES];
+	size_t   consoleSize[MAX_LANES];
+	cpu_core scratch;              // a lane's registers and memory while it runs a syscall
+
+	// stats
+	uint64_t steps;                // instructions issued to all the lanes at that PC
+	uint64_t executed[MAX_LANES];
+	uint64_t divergentBranches;    // branches the active lanes did not agree on
+	double   seconds;
+
+	void syscall(int lane);
+};
+
+#endif /* _LANES_H_ */
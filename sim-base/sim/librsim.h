@@ -0,0 +1,66 @@
+#ifndef _LIBRSIM_H_
+#define _LIBRSIM_H_
+#include <stdio.h>
+#include "cpu.h"
+#include "memory.h"
+
+// librsim: one simulated core and its memory, for programs that run many jobs in-process rather
+// than starting rsim and reading its output for each. Mapping the memory is what costs, so a
+// simulator is made once and reset between jobs. A job is what a --batch line can run: one core
+// on any of the pipeline models, set up by the same cpu_options the command line fills in.
+//
+//	simulator sim;
+//	cpu_options opts;
+//	opts.branchPredictor = 2;
+//	sim.load_text(text, textSize);
+//	sim.start(opts);
+//	while (sim.step(10000)) {
+//		printf("%u clocks, PC 0x%x\n", sim.core().cycles, sim.core().PC);
+//	}
+//	printf("%s after %u clocks\n", sim.status(), sim.counters().cycles);
+//	sim.reset();
+//
+// Faults do not escape as exceptions: the job stops and status() names the fault. A text image
+// that is not a program faults with "Illegal instruction" at its first unknown opcode.
+class simulator {
+public:
+	simulator();
+	~simulator();
+
+	// Copies an image into the start of .text or .data. Load before start(); the bytes are not
+	// counted in memory_counters().
+	void load_text(const byte *bytes, size_t size);
+	void load_data(const byte *bytes, size_t size);
+
+	// Starts the loaded program on a clean core. Syscall 8 reads input, and the syscalls print to
+	// console; with NULL the program sees end of file and its output is dropped. Both stay the
+	// caller's. -n, -D, -y and the reports are command line only, and ignored here.
+	void start(const cpu_options &opts, FILE *input = NULL, FILE *console = NULL);
+
+	// Runs up to clocks more clocks. False once the program has stopped.
+	bool step(uint32_t clocks);
+
+	// Runs the program until it stops.
+	run_result run();
+
+	// Ends the job and zeroes the memory, keeping it mapped, ready for the next load.
+	void reset();
+
+	const char  *status();          // NULL while running, then "exit", "limit" (-x) or the CPU fault
+	run_result   counters();        // cycles and branch counts so far
+	memory_stats memory_counters(); // accesses since the first start() after reset()
+	const cpu_core &core();         // PC, registers and every other counter the core keeps
+	memory &ram() { return mem; }   // for reading what the program left behind
+
+private:
+	memory mem;
+	core_context *context;
+	FILE *noInput, *noConsole;      // /dev/null, for start() without files
+	bool started;                   // a job has been started since the last reset()
+	run_result result;              // as of the last step()
+
+	simulator(const simulator &);
+	simulator &operator=(const simulator &);
+};
+
+#endif /* _LIBRSIM_H_ */
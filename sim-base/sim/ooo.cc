@@ -0,0 +1,317 @@
+#include "ooo.h"
+#include <stdio.h>
+
+ooo_pipeline::ooo_pipeline(cpu_core *c, const cpu_options &opts)
+{
+	core = c;
+	width = opts.width ? opts.width : 1;
+	aluPorts = opts.aluPorts ? opts.aluPorts : width;
+	memPorts = opts.memPorts ? opts.memPorts : 1;
+
+	rob.resize(opts.robSize);
+	robHead = 0;
+	robCount = 0;
+	rsSize = opts.rsSize ? opts.rsSize : (opts.robSize + 1) / 2;
+	for (int x = 0; x < 32; x++) renameMap[x] = -1;
+	for (int x = 0; x < FU_COUNT; x++) unitFree[x] = 0;
+	nextSeq = 0;
+	serializing = false;
+	redirected = false;
+	redirectedAt = 0;
+
+	committed = 0;
+	robOccupancy = 0;
+	robFullStalls = 0;
+	rsFullStalls = 0;
+	serializeStalls = 0;
+	issuedOutOfOrder = 0;
+	operandWaitCycles = 0;
+	unitStalls = 0;
+	squashed = 0;
+}
+
+
+// One clock, back to front like the other models: commit frees entries before rename
+// fills them, and results complete before select looks for ready operands.
+void ooo_pipeline::cycle()
+{
+	commit();
+	complete();
+	resolve();
+	issue();
+	rename();
+	fetch();
+	robOccupancy += robCount;
+}
+
+
+bool ooo_pipeline::writes_register(const rob_entry &e) const
+{
+	return e.d.control()->register_write && e.d.Rdest;
+}
+
+
+// Stores write memory at commit, so a load may not pass one.
+bool ooo_pipeline::older_store_pending(int idx) const
+{
+	for (int n = 0; n < robCount && slot(n) != idx; n++) {
+		if (rob[slot(n)].d.control()->mem_write) return true;
+	}
+	return false;
+}
+
+
+void ooo_pipeline::commit()
+{
+	for (int n = 0; n < width && robCount && core->usermode; n++) {
+		rob_entry &e = rob[robHead];
+		const instruction *control = e.d.control();
+
+		if (control->special_case != NULL) {
+			// everything older has committed, so registers[] is exactly what the syscall expects
+			control->special_case(core);
+			serializing = false;
+		}
+		else if (!e.done || (control->branch && !e.d.resolved)) {
+			break;
+		}
+		if (control->mem_write) {
+			cache_access(core, control, e.result); // the store buffer hides the latency
+			memory_access(core, control, e.result, e.d.Rsrc2Val);
+		}
+		if (writes_register(e)) {
+			core->registers[e.d.Rdest].value = e.result;
+			if (renameMap[e.d.Rdest] == robHead) renameMap[e.d.Rdest] = -1;
+		}
+		if (core->verbose) printf("0x%08x commit '%s'\n", (unsigned)e.d.PC, control->name);
+
+		robHead = slot(1);
+		robCount--;
+		committed++;
+	}
+}
+
+
+// Writeback: finished instructions wake up the reservation station entries waiting on them.
+void ooo_pipeline::complete()
+{
+	for (int n = 0; n < robCount; n++) {
+		int idx = slot(n);
+		rob_entry &e = rob[idx];
+
+		if (!e.issued || e.done || e.completeCycle > core->cycles) continue;
+		e.done = true;
+		for (size_t x = 0; x < rs.size(); x++) {
+			rob_entry &w = rob[rs[x]];
+			if (w.tag1 == idx) {
+				w.d.Rsrc1Val = e.result;
+				w.tag1 = -1;
+			}
+			if (w.tag2 == idx) {
+				w.d.Rsrc2Val = e.result;
+				w.tag2 = -1;
+			}
+		}
+	}
+}
+
+
+// Branches whose outcome is known are resolved oldest first; a younger branch waits for the
+// older ones so the predictor, history and stats see the same branches the in-order models do.
+void ooo_pipeline::resolve()
+{
+	for (int n = 0; n < robCount; n++) {
+		int idx = slot(n);
+		rob_entry &e = rob[idx];
+
+		if (!e.d.control()->branch || e.d.resolved) continue;
+		if (!e.done) break;
+		e.d.resolved = true;
+		if (resolve_branch(core, e.d, e.taken)) {
+			squash_after(idx);
+			break;
+		}
+	}
+}
+
+
+void ooo_pipeline::squash_after(int idx)
+{
+	int keep = (idx - robHead + (int)rob.size()) % (int)rob.size() + 1;
+	squashed += (robCount - keep) + fetched.size();
+	robCount = keep;
+	fetched.clear();
+	redirected = true;
+	if (!redirectedAt) redirectedAt = core->cycles; // branchFlushCycles counts on to the first right-path rename
+
+	// drop the wrong path from the reservation station
+	size_t kept = 0;
+	for (size_t x = 0; x < rs.size(); x++) {
+		if (rob[rs[x]].seq < rob[idx].seq) rs[kept++] = rs[x];
+	}
+	rs.resize(kept);
+
+	// rebuild the rename table from what is left
+	for (int x = 0; x < 32; x++) renameMap[x] = -1;
+	for (int n = 0; n < robCount; n++) {
+		if (writes_register(rob[slot(n)])) renameMap[rob[slot(n)].d.Rdest] = slot(n);
+	}
+	if (serializing) {
+		serializing = false;
+		for (int n = 0; n < robCount; n++) {
+			if (rob[slot(n)].d.control()->special_case != NULL) serializing = true;
+		}
+	}
+}
+
+
+// Select: the oldest ready entries, up to width and the port limits.
+void ooo_pipeline::issue()
+{
+	int issued = 0, aluUsed = 0, memUsed = 0;
+	bool olderWaiting = false;
+
+	// rs is kept in program order, so the scan is oldest first
+	for (size_t x = 0; x < rs.size() && issued < width; ) {
+		rob_entry &e = rob[rs[x]];
+		const instruction *control = e.d.control();
+		bool is_mem = control->mem_read || control->mem_write;
+
+		if (e.tag1 != -1 || e.tag2 != -1) {
+			operandWaitCycles++;
+			olderWaiting = true;
+			x++;
+			continue;
+		}
+		bool is_alu = !is_mem && control->unit == FU_ALU;
+		if ((is_mem && memUsed == memPorts) || (is_alu && aluUsed == aluPorts) ||
+		    (control->mem_read && older_store_pending(rs[x]))) {
+			olderWaiting = true;
+			x++;
+			continue;
+		}
+		if (control->unit != FU_ALU && unitFree[control->unit] > core->cycles) {
+			unitStalls++;
+			olderWaiting = true;
+			x++;
+			continue;
+		}
+		if (is_mem) memUsed++;
+		if (is_alu) aluUsed++;
+		if (control->unit != FU_ALU) unitFree[control->unit] = core->cycles + functional_units[control->unit].interval;
+		if (olderWaiting) issuedOutOfOrder++;
+
+		e.issued = true;
+		e.result = alu_result(e.d);
+		e.completeCycle = core->cycles + control->exe_cycles;
+		if (control->mem_read) {
+			e.completeCycle += 1 + cache_access(core, control, e.result);
+			e.result = memory_access(core, control, e.result, 0);
+		}
+		if (control->branch) {
+			e.taken = branch_condition(e.d.opcode, e.d.Rsrc1Val, e.d.Rsrc2Val);
+		}
+		rs.erase(rs.begin() + x);
+		issued++;
+	}
+}
+
+
+void ooo_pipeline::read_operand(byte reg, int32_t *val, int *tag)
+{
+	int producer = reg ? renameMap[reg] : -1;
+
+	*tag = -1;
+	if (producer == -1) {
+		*val = reg ? *(int32_t *)&core->registers[reg].value : 0;
+	}
+	else if (rob[producer].done) {
+		*val = *(int32_t *)&rob[producer].result;
+	}
+	else {
+		*val = 0;
+		*tag = producer;
+	}
+}
+
+
+// In-order rename and dispatch into the ROB and reservation station.
+void ooo_pipeline::rename()
+{
+	size_t taken = 0;
+
+	for (; taken < fetched.size() && (int)taken < width; taken++) {
+		const instruction *control = &instructions[fetched[taken].opcode];
+		bool needs_rs = fetched[taken].opcode != 0 && control->special_case == NULL;
+
+		if (serializing) {
+			serializeStalls++;
+			break;
+		}
+		if (robCount == (int)rob.size()) {
+			robFullStalls++;
+			break;
+		}
+		if (needs_rs && rs.size() == rsSize) {
+			rsFullStalls++;
+			break;
+		}
+
+		if (redirectedAt) {
+			core->branchFlushCycles += core->cycles - redirectedAt;
+			redirectedAt = 0;
+		}
+		int idx = slot(robCount++);
+		rob_entry &e = rob[idx];
+		e.d.load(fetched[taken]);
+		e.d.resolved = false;
+		e.seq = nextSeq++;
+		e.issued = false;
+		e.done = !needs_rs && control->special_case == NULL; // nops just wait to commit
+		e.taken = false;
+		e.result = 0;
+		e.completeCycle = 0;
+		read_operand(e.d.Rsrc1, &e.d.Rsrc1Val, &e.tag1);
+		read_operand(e.d.Rsrc2, &e.d.Rsrc2Val, &e.tag2);
+
+		if (writes_register(e)) renameMap[e.d.Rdest] = idx;
+		if (control->special_case != NULL) serializing = true;
+		if (needs_rs) rs.push_back(idx);
+	}
+	fetched.erase(fetched.begin(), fetched.begin() + taken);
+}
+
+
+void ooo_pipeline::fetch()
+{
+	if (redirected) {
+		redirected = false;
+		return;
+	}
+	while (fetched.size() < (size_t)width) {
+		IDl l;
+		read_instruction(core, core->PC, l);
+		predict_branch(core, l);
+		fetched.push_back(l);
+		if (l.predict_taken) {
+			break;
+		}
+	}
+}
+
+
+void ooo_pipeline::display_stats()
+{
+	printf("stat.ooo: width %d, rob %d, rs %d (alu ports %d, memory ports %d)\n"
+	      , width, (int)rob.size(), (int)rsSize, aluPorts, memPorts);
+	printf("stat.instructions: %llu\n", (unsigned long long)committed);
+	printf("stat.IPC: %.3f\n", core->cycles ? committed / double(core->cycles) : 0.0);
+	printf("stat.robOccupancy: %.2f\n", core->cycles ? robOccupancy / double(core->cycles) : 0.0);
+	printf("stat.robFullStalls: %llu\n", (unsigned long long)robFullStalls);
+	printf("stat.rsFullStalls: %llu\n", (unsigned long long)rsFullStalls);
+	printf("stat.serializeStalls: %llu\n", (unsigned long long)serializeStalls);
+	printf("stat.operandWaitCycles: %llu\n", (unsigned long long)operandWaitCycles);
+	printf("stat.issuedOutOfOrder: %llu\n", (unsigned long long)issuedOutOfOrder);
+	printf("stat.unitStalls: %llu\n", (unsigned long long)unitStalls);
+	printf("stat.squashedInstructions: %llu\n", (unsigned long long)squashed);
+}
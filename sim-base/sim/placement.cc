@@ -0,0 +1,88 @@
+#include "placement.h"
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+
+bool parse_cpus(const char *text, std::vector<int> &cpus)
+{
+	cpu_set_t allowed;
+
+	cpus.clear();
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+		return false;
+	}
+	if (strcmp(text, "spread") == 0) {
+		std::map<int, std::vector<int> > nodes;
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &allowed)) nodes[cpu_node(cpu)].push_back(cpu);
+		}
+		for (size_t k = 0; cpus.size() < (size_t)CPU_COUNT(&allowed); k++) {
+			for (std::map<int, std::vector<int> >::iterator n = nodes.begin(); n != nodes.end(); ++n) {
+				if (k < n->second.size()) cpus.push_back(n->second[k]);
+			}
+		}
+		return !cpus.empty();
+	}
+
+	const char *p = text;
+	while (*p) {
+		char *end;
+		long first = strtol(p, &end, 10), last = first;
+		if (end == p) {
+			return false;
+		}
+		if (*end == '-') {
+			p = end + 1;
+			last = strtol(p, &end, 10);
+			if (end == p) return false;
+		}
+		if (first < 0 || last < first || last >= CPU_SETSIZE) {
+			return false;
+		}
+		for (long cpu = first; cpu <= last; cpu++) {
+			if (!CPU_ISSET(cpu, &allowed)) return false;
+			cpus.push_back(cpu);
+		}
+		if (*end == ',') end++;
+		else if (*end) return false;
+		p = end;
+	}
+	return !cpus.empty();
+}
+
+
+void pin_thread(int cpu)
+{
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+
+// sysfs lists a CPU's node as a nodeN entry in the CPU's directory.
+int cpu_node(int cpu)
+{
+	char path[64];
+	int  node = 0;
+
+	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+	DIR *dir = opendir(path);
+	if (!dir) {
+		return 0;
+	}
+	for (dirent *e = readdir(dir); e; e = readdir(dir)) {
+		if (strncmp(e->d_name, "node", 4) == 0 && isdigit((unsigned char)e->d_name[4])) {
+			node = atoi(e->d_name + 4);
+			break;
+		}
+	}
+	closedir(dir);
+	return node;
+}
@@ -0,0 +1,20 @@
+#ifndef _PLACEMENT_H_
+#define _PLACEMENT_H_
+#include <vector>
+
+// -a: where the host threads of a parallel run go. Thread x is pinned to cpus[x % cpus.size()].
+// Memory is mapped lazily, and the kernel puts a page on the node of the CPU that first touches
+// it, so a pinned thread that builds its own memory and core keeps them on its own node.
+
+// Parses a list like "0-3,8" into cpus, or "spread": every CPU rsim may run on, taking the NUMA
+// nodes in turn so that neighbouring threads land on different nodes. False if text names a
+// CPU rsim may not run on.
+bool parse_cpus(const char *text, std::vector<int> &cpus);
+
+// Pins the calling thread to cpu.
+void pin_thread(int cpu);
+
+// The NUMA node cpu belongs to (0 on hosts without NUMA).
+int cpu_node(int cpu);
+
+#endif /* _PLACEMENT_H_ */
@@ -0,0 +1,85 @@
+#ifndef _PREDICTOR_H_
+#define _PREDICTOR_H_
+#include <stdint.h>
+#include "types.h"
+
+// Functional branch predictor models. These mirror the -b predictors built into
+// InstructionFetchStage/ExecuteStage, but predict and train in one step instead of
+// across the pipeline, so they can be driven from a trace or run as shadows.
+//
+// The concrete classes are final so that a loop templated on one of them
+// (see bpsim.cc) gets its calls inlined; everything else goes through the base class.
+class predictor {
+public:
+	virtual ~predictor() {}
+	virtual const char *name() const = 0;
+	virtual bool predict(uint32_t pc, uint32_t target, byte hint) = 0;
+	virtual void update(uint32_t pc, uint32_t target, bool taken) = 0;
+};
+
+// 0 = Always not taken
+class not_taken_predictor final : public predictor {
+public:
+	const char *name() const { return "not-taken"; }
+	bool predict(uint32_t, uint32_t, byte) { return false; }
+	void update(uint32_t, uint32_t, bool) {}
+};
+
+// 1 = Always taken
+class taken_predictor final : public predictor {
+public:
+	const char *name() const { return "taken"; }
+	bool predict(uint32_t, uint32_t, byte) { return true; }
+	void update(uint32_t, uint32_t, bool) {}
+};
+
+// saturating two bit counter, 0/1 not taken, 2/3 taken
+static inline void train_2bit(int &state, bool taken)
+{
+	if (taken && state < 3) state++;
+	if (!taken && state > 0) state--;
+}
+
+// 2 = 2 Bit Predictor, a table of counters indexed by the PC
+class twobit_predictor final : public predictor {
+	int table[1024];
+public:
+	twobit_predictor();
+	const char *name() const { return "two-bit"; }
+
+	static int index(uint32_t pc) { return (pc >> 3) % 1024; }
+	bool predict(uint32_t pc, uint32_t, byte) { return table[index(pc)] > 1; }
+	void update(uint32_t pc, uint32_t, bool taken) { train_2bit(table[index(pc)], taken); }
+};
+
+// 3 = 2 Level Predictor, the same counters indexed by the last 10 branch outcomes
+class twolevel_predictor final : public predictor {
+	int table[1024];
+	uint32_t history;
+public:
+	twolevel_predictor();
+	const char *name() const { return "two-level"; }
+
+	bool predict(uint32_t, uint32_t, byte) { return table[history] > 1; }
+	void update(uint32_t, uint32_t, bool taken)
+	{
+		train_2bit(table[history], taken);
+		history = ((history << 1) | (taken ? 1 : 0)) & 0x3ff;
+	}
+};
+
+// 4 = Static hints; backward taken, forward not taken when there is no hint
+class hint_predictor final : public predictor {
+public:
+	const char *name() const { return "hints"; }
+	bool predict(uint32_t pc, uint32_t target, byte hint)
+	{
+		return hint == HINT_TAKEN || (hint == HINT_NONE && target <= pc);
+	}
+	void update(uint32_t, uint32_t, bool) {}
+};
+
+// Returns a new predictor for the -b number, or NULL if there is no such predictor.
+predictor *make_predictor(int kind);
+
+#endif /* _PREDICTOR_H_ */
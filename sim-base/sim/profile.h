@@ -0,0 +1,66 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <set>
+
+// Everything we know about one static branch (one PC) after a run.
+struct branch_record {
+	uint32_t pc;
+	uint32_t executed;
+	uint32_t taken;
+	uint32_t mispredicts;
+	int      lastIndex;         // predictor table index used on the last execution (-1: no table)
+	std::set<int> indices;      // every table index this branch has touched
+
+	branch_record() : pc(0), executed(0), taken(0), mispredicts(0), lastIndex(-1) {}
+
+	double taken_rate() const
+	{
+		return executed ? taken / double(executed) : 0.0;
+	}
+
+	double mispredict_rate() const
+	{
+		return executed ? mispredicts / double(executed) : 0.0;
+	}
+};
+
+// Per-static-branch profile, filled in as branches resolve in the execute stage.
+class branch_profile {
+	typedef std::map<uint32_t, branch_record> records_t;
+	records_t records;
+
+	// number of other static branches sharing at least one table entry with r
+	uint32_t aliases(const branch_record &r, const std::map<int, std::set<uint32_t> > &owners) const;
+	void index_owners(std::map<int, std::set<uint32_t> > &owners) const;
+
+public:
+	void record(uint32_t pc, bool taken, bool mispredict, int index);
+
+	// print the top_n branches with the most mispredicts
+	void display(FILE *out, int top_n) const;
+
+	// one line per static branch, sorted by PC. returns false if the file could not be written.
+	bool write_csv(const char *filename) const;
+};
+
+// Load-use bubbles in the five stage pipeline, charged to the load that caused them.
+class load_use_profile {
+	struct load_record {
+		uint32_t stalls;
+		std::set<uint32_t> users;   // PCs of the instructions that waited on this load
+		load_record() : stalls(0) {}
+	};
+	typedef std::map<uint32_t, load_record> records_t;
+	records_t records;
+
+public:
+	void record(uint32_t load_pc, uint32_t use_pc);
+
+	// print the top_n loads with the most bubbles
+	void display(FILE *out, int top_n) const;
+};
+
+#endif /* _PROFILE_H_ */
@@ -0,0 +1,24 @@
+#ifndef _SERVER_H_
+#define _SERVER_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include "cpu.h"
+
+// One --serve request, parsed: its options and the images it loads.
+struct server_job {
+	std::vector<char> words;                          // the request split up; opts points into it
+	cpu_options opts;
+	std::shared_ptr<const std::vector<byte> > text;
+	std::shared_ptr<const std::vector<byte> > data;   // NULL: nothing in .data
+};
+
+// Parses one request line into job. False, with error set, if the request is no good.
+typedef bool (*request_parser)(const std::string &request, server_job &job, std::string &error);
+
+// Serves jobs on a Unix socket at path until the process is killed. Every line a client sends
+// holds the options of one run, and gets one line of JSON back once the run is done. With cpus
+// (-a), the thread of the nth connection is pinned to cpus[n % cpus.size()].
+void run_server(const char *path, const std::vector<int> &cpus, request_parser parse);
+
+#endif /* _SERVER_H_ */
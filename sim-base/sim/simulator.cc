@@ -1,10 +1,22 @@
 #include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
 #include "memory.h"
 #include "cpu.h"
+#include "batch.h"
+#include "server.h"
+#include "lanes.h"
+#include "placement.h"
 
 extern char   *optarg;
 extern int32_t optind;
@@ -19,79 +31,686 @@ static void usage(char *name)
 {
 	cout << name << " usage:\n" <<
 	        "\t-t text_stream_file: load .text with the contents of file\n" <<
-	        "\t-d data_stream_file: [optional] load .data with contents of file\n" << endl;
+	        "\t-d data_stream_file: [optional] load .data with contents of file\n" <<
+	        "\t-D data_stream_file: [optional] one lane of the functional lockstep model, with this .data (repeat for up to 16 lanes)\n" <<
+	        "\t   a second -t (and the -d after it) is a second SMT thread, run on the superscalar model\n" <<
+	        "\t-i policy: [optional] SMT fetch policy, rr (round robin, default) or icount\n" <<
+	        "\t-n cores: [optional] run cores copies of the program on shared memory, one host thread each\n" <<
+	        "\t-q clocks: [optional] clocks each core runs between barriers with -n (default 1000)\n" <<
+	        "\t-c size,assoc,line: [optional] MESI-coherent L1 data cache per core, sizes in bytes\n" <<
+	        "\t-x clocks: [optional] stop after clocks cycles\n" <<
+	        "\t-I input_file: [optional] syscall 8 reads this file instead of stdin\n" <<
+	        "\t-y clocks: [optional] run this many clocks, then fork a child for each -Y from the warmed state\n" <<
+	        "\t-Y \"options\": [optional] a what-if for -y: the -b, -H, -c, -I and -x the child carries on with\n" <<
+	        "\t-K checkpoint_file: [optional] write the core and memory to file when -x stops the core\n" <<
+	        "\t-r checkpoint_file: [optional] carry on from a -K checkpoint instead of -t and -d\n" <<
+	        "\t-a cpus: [optional] pin the host threads (-n cores, -y children) to these CPUs, like 0-3,8, or spread across NUMA nodes\n" <<
+	        "\t-b predictor: [optional] 0 not taken, 1 taken, 2 two-bit, 3 two-level, 4 static hints\n" <<
+	        "\t-H: [optional] static hints override weakly biased -b 2/3 predictions\n" <<
+	        "\t-e: [optional] resolve branches early, in the decode stage\n" <<
+	        "\t-f: [optional] fuse addi/subi with a following branch on its result into one op\n" <<
+	        "\t-Q depth: [optional] decoupled front end with an instruction queue of depth entries\n" <<
+	        "\t-F depth: [optional] fetch target queue entries with -Q (default the -Q depth)\n" <<
+	        "\t-l entries: [optional] replay short backward loops from a loop buffer of entries instructions\n" <<
+	        "\t-w width: [optional] use the superscalar model, issuing up to width instructions per clock\n" <<
+	        "\t-k depth: [optional] split fetch, execute and memory into depth sub-stages each (superscalar model, width 1 unless -w)\n" <<
+	        "\t-A count: [optional] superscalar ALU ports (default width)\n" <<
+	        "\t-M count: [optional] superscalar memory ports (default 1)\n" <<
+	        "\t-S: [optional] superscalar scoreboard: let independent instructions pass a busy functional unit\n" <<
+	        "\t-W count: [optional] results written back per clock with -S (default width)\n" <<
+	        "\t-o entries: [optional] use the out-of-order model with a reorder buffer of this size (width from -w)\n" <<
+	        "\t-R entries: [optional] out-of-order reservation station entries (default half the ROB)\n" <<
+	        "\t-v: [optional] very verbose cpu\n" <<
+	        "\t-p count: [optional] report the count hardest-to-predict branches\n" <<
+	        "\t-P csv_file: [optional] write the per-branch profile to file\n" <<
+	        "\t-L count: [optional] report the count loads causing the most load-use stalls\n" <<
+	        "\t-T trace_file: [optional] record every resolved branch to file (replay with bpsim)\n" <<
+	        "\t-s predictors: [optional] comma separated -b numbers to score as shadows of -b\n" <<
+	        name << " --batch manifest results.csv [-j workers] [-a cpus]: run every line of manifest as a job, options as above\n" <<
+	        name << " --serve socket_path [-a cpus]: run the jobs clients send over a Unix socket, one line of options each\n" << endl;
 }
 
 
-// *****************************
-//           entry point
-// *****************************
-int32_t main(int32_t argc, char **argv)
+// A bad command line. main prints the message, or the usage if there is none, and exits with
+// code; --serve sends the message back to the client instead.
+struct option_error {
+	int code;             // 10: bad options, 20: a file is missing
+	std::string message;
+
+	option_error(int c, const std::string &m) : code(c), message(m) {}
+};
+
+
+// Readies getopt for a new argv. glibc only forgets how far into the last word it had got
+// (still pointing into it if an error cut the parse short) when optind is set to 0.
+static void restart_getopt()
 {
-	memory   mem;
-	bool     verb = false;
-	bool     text_loaded = false;
+#ifdef __GLIBC__
+	optind = 0;
+#else
+	optind = 1;
+	optreset = 1;
+#endif
+}
+
+
+static bool power_of_two(int x)
+{
+	return x > 0 && (x & (x - 1)) == 0;
+}
+
+
+// -c size,assoc,line
+static void parse_cache(const char *name, const char *arg, int &size, int &assoc, int &line)
+{
+	if (sscanf(arg, "%d,%d,%d", &size, &assoc, &line) != 3 ||
+	    !power_of_two(size) || !power_of_two(assoc) || !power_of_two(line) ||
+	    line < 4 || line > 64 || size < assoc * line) {
+		throw option_error(10, std::string(name) + ": -c wants size,assoc,line in bytes, powers of two, lines of 4 to 64 bytes");
+	}
+}
+
+
+// -b predictor, for the run itself and -Y
+static int parse_predictor(const char *name, const char *arg)
+{
+	predictor *p = make_predictor(atoi(arg));
+	if (!p) {
+		throw option_error(10, std::string(name) + ": no predictor " + arg + ", -b wants 0 to 4");
+	}
+	delete p;
+	return atoi(arg);
+}
+
+
+// -a cpus, for the run itself, --batch and --serve
+static void parse_host_cpus(const char *name, const char *arg, std::vector<int> &cpus)
+{
+	if (!parse_cpus(arg, cpus)) {
+		throw option_error(10, std::string(name) + ": -a wants a list like 0-3,8 of CPUs rsim may run on, or spread");
+	}
+}
+
+
+// -Y: the options a forked child changes, starting from the parent's.
+static what_if parse_what_if(const char *name, const char *text, const cpu_options &opts)
+{
+	what_if w = { text, opts.branchPredictor, opts.hintOverride, opts.cacheSize, opts.cacheAssoc, opts.cacheLine,
+	              NULL, opts.maxCycles };
+	std::vector<char *> args(1, (char *)name);
+	std::string list = text;
 	int32_t  ch;
-	uint32_t text_ptr = text_segment;
-	uint32_t data_ptr = data_segment;
-	int branchPredictor = 0; // I added this line
 
-	while ((ch = getopt(argc, argv, "t:d:vb:")) != -1) {
+	for (char *tok = strtok(&list[0], " \t"); tok; tok = strtok(NULL, " \t")) {
+		args.push_back(tok);
+	}
+	args.push_back(NULL);
+	restart_getopt();
+	opterr = 0;  // the message below says more
+	while ((ch = getopt(args.size() - 1, &args[0], "b:Hc:I:x:")) != -1) {
+		switch (ch) {
+		case 'b':
+			w.branchPredictor = parse_predictor(name, optarg);
+			break;
+
+		case 'H':
+			w.hintOverride = true;
+			break;
+
+		case 'c':
+			parse_cache(name, optarg, w.cacheSize, w.cacheAssoc, w.cacheLine);
+			break;
+
+		case 'I':
+			if (access(optarg, R_OK) != 0) {
+				throw option_error(20, std::string(name) + ": " + optarg + " does not exist");
+			}
+			w.inputFile = strdup(optarg);
+			break;
+
+		case 'x':
+			w.maxCycles = atoi(optarg);
+			break;
+
+		default:
+			throw option_error(10, std::string(name) + ": -Y \"" + text + "\" can only change -b, -H, -c, -I and -x");
+		}
+	}
+	opterr = 1;
+	return w;
+}
+
+
+// The files a -t and the -d after it name.
+struct image_files {
+	const char *text;
+	const char *data;  // NULL: nothing in .data
+};
+
+
+// Reads a .text or .data image.
+static void read_image(const char *name, const char *path, std::vector<byte> &bytes)
+{
+	ifstream input(path, ios::binary);
+	if (!(input.good() && input.is_open())) {
+		throw option_error(20, std::string(name) + ": " + path + " does not exist");
+	}
+	byte  c;
+	char *pc = (char *)&c;
+	while (!input.eof()) {
+		input.read(pc, sizeof(byte));
+		bytes.push_back(c);
+	}
+	input.close();
+}
+
+
+static void load_image(memory *m, const std::vector<byte> &bytes, uint32_t addr)
+{
+	if (!bytes.empty()) m->load(addr, &bytes[0], bytes.size());
+}
+
+
+// Parses rsim's options into opts and the images to load, one per thread, and the -D .data
+// images, one per lane. Throws option_error on anything wrong; *argv names the offender (the
+// program, or the manifest line with --batch).
+static void parse_options(int32_t argc, char **argv, cpu_options &opts, std::vector<image_files> &images, std::vector<const char *> &lanes)
+{
+	int32_t  ch;
+	int32_t  quantum = opts.quantum;
+	int32_t  maxCycles = 0;
+	int32_t  forkAt = 0;
+	std::vector<const char *> whatIfs;
+
+	restart_getopt();
+	while ((ch = getopt(argc, argv, "t:d:D:vb:efHp:P:T:s:w:A:M:SW:o:R:L:Q:F:l:k:i:n:q:c:x:I:y:Y:K:r:a:")) != -1) {
 		switch (ch) {
 		case 't': {
 			ifstream input(optarg, ios::binary);
 			if (!(input.good() && input.is_open())) {
-				cout << *argv << ": " << optarg << " does not exist" << endl;
-				exit(20);
+				throw option_error(20, std::string(*argv) + ": " + optarg + " does not exist");
 			}
-			byte  c;
-			char *pc = (char *)&c;
-			while (!input.eof()) {
-				input.read(pc, sizeof(byte));
-				mem.set<byte>(text_ptr++, c);
+			if (!images.empty() && !images.back().text) {
+				images.back().text = optarg;  // after a -d that came first
+				break;
 			}
-			input.close();
-			text_loaded = true;
+			if (images.size() == 2) {
+				throw option_error(10, std::string(*argv) + ": at most two threads");
+			}
+			image_files f = { optarg, NULL };
+			images.push_back(f);
 		}
 		break;
 		case 'd': {
 			ifstream input(optarg, ios::binary);
 			if (!(input.good() && input.is_open())) {
-				cout << *argv << ": " << optarg << " does not exist" << endl;
-				exit(20);
+				throw option_error(20, std::string(*argv) + ": " + optarg + " does not exist");
 			}
-			byte c;
-			while (!input.eof()) {
-				input.read((char *)&c, sizeof(byte));
-				mem.set<byte>(data_ptr++, c);
+			if (images.empty()) {
+				// .data before any .text still goes with the first thread
+				image_files f = { NULL, NULL };
+				images.push_back(f);
 			}
-			input.close();
+			images.back().data = optarg;
+		}
+		break;
+		case 'D': {
+			ifstream input(optarg, ios::binary);
+			if (!(input.good() && input.is_open())) {
+				throw option_error(20, std::string(*argv) + ": " + optarg + " does not exist");
+			}
+			if (lanes.size() == (size_t)MAX_LANES) {
+				throw option_error(10, std::string(*argv) + ": at most " + std::to_string(MAX_LANES) + " lanes");
+			}
+			lanes.push_back(optarg);
 		}
 		break;
-
 		case 'b': 
 			//<CAR_PA1_HOOK1>
-			branchPredictor = atoi(optarg); // Read in the predictor to use assigned by a #
+			opts.branchPredictor = parse_predictor(*argv, optarg); // Read in the predictor to use assigned by a #
+		break;
+
+		case 'Q':
+			opts.iqDepth = atoi(optarg);
+			break;
+
+		case 'F':
+			opts.ftqDepth = atoi(optarg);
+			break;
+
+		case 'l':
+			opts.loopBuffer = atoi(optarg);
+			break;
+
+		case 'w':
+			opts.width = atoi(optarg);
+			break;
+
+		case 'i':
+			if (strcmp(optarg, "rr") == 0) opts.fetchPolicy = FETCH_ROUND_ROBIN;
+			else if (strcmp(optarg, "icount") == 0) opts.fetchPolicy = FETCH_ICOUNT;
+			else {
+				throw option_error(10, "");
+			}
+			break;
+
+		case 'k':
+			opts.depth = atoi(optarg);
+			if (opts.depth < 1) {
+				throw option_error(10, "");
+			}
+			break;
+
+		case 'n':
+			opts.cores = atoi(optarg);
+			break;
+
+		case 'q':
+			quantum = atoi(optarg);
+			break;
+
+		case 'x':
+			maxCycles = atoi(optarg);
+			break;
+
+		case 'I':
+			opts.inputFile = optarg;
+			break;
+
+		case 'c':
+			parse_cache(*argv, optarg, opts.cacheSize, opts.cacheAssoc, opts.cacheLine);
+			break;
+
+		case 'y':
+			forkAt = atoi(optarg);
+			break;
+
+		case 'K':
+			opts.checkpointFile = optarg;
+			break;
+
+		case 'r':
+			if (access(optarg, R_OK) != 0) {
+				throw option_error(20, std::string(*argv) + ": " + optarg + " does not exist");
+			}
+			opts.restoreFile = optarg;
+			break;
+
+		case 'a':
+			parse_host_cpus(*argv, optarg, opts.hostCpus);
+			break;
+
+		case 'Y':
+			whatIfs.push_back(optarg);
+			break;
+
+		case 'A':
+			opts.aluPorts = atoi(optarg);
+			break;
+
+		case 'M':
+			opts.memPorts = atoi(optarg);
+			break;
+
+		case 'S':
+			opts.scoreboard = true;
+			break;
+
+		case 'W':
+			opts.wbPorts = atoi(optarg);
+			break;
+
+		case 'o':
+			opts.robSize = atoi(optarg);
+			break;
+
+		case 'R':
+			opts.rsSize = atoi(optarg);
+			break;
+
+		case 'e':
+			opts.earlyBranch = true;
+			break;
+
+		case 'f':
+			opts.fusion = true;
+			break;
+
+		case 'H':
+			opts.hintOverride = true;
+			break;
+
+		case 'p':
+			opts.profileTop = atoi(optarg);
+			break;
+
+		case 'L':
+			opts.loadUseTop = atoi(optarg);
+			break;
+
+		case 'P':
+			opts.profileCsv = optarg;
+			break;
+
+		case 'T':
+			opts.traceFile = optarg;
+			break;
+
+		case 's': {
+			char *list = strdup(optarg);
+			for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+				predictor *p = make_predictor(atoi(tok));
+				if (!p) {
+					std::string bad = tok;
+					free(list);
+					throw option_error(10, std::string(*argv) + ": no predictor " + bad);
+				}
+				delete p;
+				opts.shadowPredictors.push_back(atoi(tok));
+			}
+			free(list);
+		}
 		break;
 
 		case 'v':
-			verb = true;
+			opts.verbose = true;
 			break;
 
 		default:
-			usage(*argv);
-			exit(10);
+			throw option_error(10, "");
 			break;
 		}
 	}
 
-	if (!text_loaded) {
-		usage(*argv);
+	bool thread2 = images.size() > 1;
+	if ((!opts.restoreFile && (images.empty() || !images[0].text)) || opts.width < 0 || opts.aluPorts < 0 || opts.memPorts < 0 ||
+	    opts.iqDepth < 0 || opts.ftqDepth < 0 || opts.loopBuffer < 0 || opts.wbPorts < 0 || opts.robSize < 0 || opts.rsSize < 0 ||
+	    ((opts.depth || thread2) && opts.robSize) || opts.cores < 1 || quantum < 1 || maxCycles < 0 ||
+	    forkAt < 0 || (forkAt > 0) != !whatIfs.empty()) {
+		throw option_error(10, "");
+	}
+	if (opts.cores > 1 && (thread2 || opts.verbose || opts.traceFile || opts.profileCsv)) {
+		// each core would need its own file, and -v lines from several threads interleave
+		throw option_error(10, std::string(*argv) + ": -n cannot be combined with a second -t, -v, -T or -P");
+	}
+	if (opts.cacheSize && thread2) {
+		throw option_error(10, std::string(*argv) + ": -c cannot be combined with a second -t");
+	}
+	if (!lanes.empty() && (thread2 || images[0].data || opts.width || opts.depth || opts.robSize || opts.cores > 1 ||
+	    opts.cacheSize || opts.verbose || opts.traceFile || opts.profileCsv || opts.profileTop >= 0 || opts.loadUseTop >= 0)) {
+		// the lockstep model has no pipeline to widen, deepen or report on
+		throw option_error(10, std::string(*argv) + ": -D cannot be combined with -d, a second -t, -w, -k, -o, -n, -c, -v, -T, -P, -p or -L");
+	}
+	if (forkAt && (opts.cores > 1 || !lanes.empty() || opts.traceFile || opts.profileCsv)) {
+		// fork() copies one thread, and the children would share the files
+		throw option_error(10, std::string(*argv) + ": -y cannot be combined with -n, -D, -T or -P");
+	}
+	if (opts.restoreFile && !images.empty()) {
+		throw option_error(10, std::string(*argv) + ": -r restores memory from the checkpoint, so it cannot be combined with -t or -d");
+	}
+	if (opts.checkpointFile && !maxCycles) {
+		throw option_error(10, std::string(*argv) + ": -K writes the checkpoint where -x stops the core, so it needs -x");
+	}
+	if ((opts.checkpointFile || opts.restoreFile) && (thread2 || !lanes.empty() || opts.width || opts.depth || opts.robSize ||
+	    opts.cores > 1 || opts.cacheSize || !opts.shadowPredictors.empty() || forkAt)) {
+		// only the five stage pipeline's state is saved
+		throw option_error(10, std::string(*argv) + ": -K and -r cannot be combined with a second -t, -D, -w, -k, -o, -n, -c, -s or -y");
+	}
+	opts.quantum = quantum;
+	opts.maxCycles = maxCycles;
+	opts.forkAt = forkAt;
+	for (size_t x = 0; x < whatIfs.size(); x++) {
+		opts.whatIfs.push_back(parse_what_if(*argv, whatIfs[x], opts));
+	}
+}
+
+
+// Ends the program over a bad command line.
+static void exit_with(const option_error &e, char *name)
+{
+	if (e.message.empty()) usage(name);
+	else cout << e.message << endl;
+	exit(e.code);
+}
+
+
+// --batch and --serve jobs run on one core and print nothing beside their results.
+static void check_job(const char *name, const cpu_options &opts, const std::vector<image_files> &images,
+                      const std::vector<const char *> &lanes)
+{
+	if (images.size() > 1 || !lanes.empty() || opts.cores > 1 || opts.forkAt || opts.verbose || opts.traceFile || opts.profileCsv ||
+	    opts.profileTop >= 0 || opts.loadUseTop >= 0 || opts.checkpointFile || opts.restoreFile || !opts.hostCpus.empty()) {
+		throw option_error(10, std::string(name) + ": a job cannot take a second -t, -D, -n, -y, -v, -T, -P, -p, -L, -K, -r or -a");
+	}
+	if (opts.inputFile && access(opts.inputFile, R_OK) != 0) {
+		throw option_error(20, std::string(name) + ": " + opts.inputFile + " does not exist");
+	}
+}
+
+
+// --batch manifest results.csv [-j workers] [-a cpus]: every line of the manifest holds the
+// options of one run. All of them are checked, and every image read once, before the first job
+// starts.
+static int32_t run_manifest(int32_t argc, char **argv)
+{
+	int32_t workers = sysconf(_SC_NPROCESSORS_ONLN);
+	std::vector<int> cpus;
+
+	for (int32_t x = 4; x < argc; x += 2) {
+		if (x + 1 < argc && strcmp(argv[x], "-j") == 0) workers = atoi(argv[x + 1]);
+		else if (x + 1 < argc && strcmp(argv[x], "-a") == 0) {
+			try {
+				parse_host_cpus(*argv, argv[x + 1], cpus);
+			} catch (const option_error &e) {
+				exit_with(e, *argv);
+			}
+		}
+		else workers = 0;
+	}
+	if (argc < 4 || workers < 1) {
+		cout << *argv << " usage: " << *argv << " --batch manifest results.csv [-j workers] [-a cpus]" << endl;
 		exit(10);
 	}
+
+	ifstream manifest(argv[2]);
+	if (!(manifest.good() && manifest.is_open())) {
+		cout << *argv << ": " << argv[2] << " does not exist" << endl;
+		exit(20);
+	}
+	std::map<std::string, std::vector<byte> > files;  // each image once, however many jobs load it
+	std::vector<batch_job> jobs;
+	std::vector<char *> lines;   // the jobs' options point into these
+	std::string text;
+	for (int line = 1; getline(manifest, text); line++) {
+		size_t first = text.find_first_not_of(" \t\r");
+		if (first == std::string::npos || text[first] == '#') {
+			continue;
+		}
+		std::ostringstream label;
+		label << argv[2] << ":" << line;
+		lines.push_back(strdup(label.str().c_str()));
+		std::vector<char *> args(1, lines.back());
+		lines.push_back(strdup(text.c_str()));
+		for (char *tok = strtok(lines.back(), " \t\r"); tok; tok = strtok(NULL, " \t\r")) {
+			args.push_back(tok);
+		}
+
+		batch_job job;
+		std::vector<image_files> images;
+		std::vector<const char *> lanes;
+		try {
+			parse_options(args.size(), &args[0], job.opts, images, lanes);
+			check_job(args[0], job.opts, images, lanes);
+			job.text = &files[images[0].text];
+			if (job.text->empty()) read_image(args[0], images[0].text, files[images[0].text]);
+			job.data = NULL;
+			if (images[0].data) {
+				job.data = &files[images[0].data];
+				if (job.data->empty()) read_image(args[0], images[0].data, files[images[0].data]);
+			}
+		} catch (const option_error &e) {
+			exit_with(e, args[0]);
+		}
+		job.line = line;
+		job.options = text.substr(first);
+		jobs.push_back(job);
+	}
+
+	FILE *csv = fopen(argv[3], "w");
+	if (!csv) {
+		perror(argv[3]);
+		exit(20);
+	}
+	cout << *argv << ": Starting " << jobs.size() << " jobs on " << workers << " workers..." << endl;
+	run_batch(jobs, workers, cpus, csv);
+	fclose(csv);
+	cout << *argv << ": Batch Finished" << endl;
+	for (size_t x = 0; x < lines.size(); x++) {
+		free(lines[x]);
+	}
+	return 0;
+}
+
+
+// --serve: the images requests have loaded, by path, read again once the file changes.
+struct cached_image {
+	time_t mtime;
+	off_t  size;
+	std::shared_ptr<const std::vector<byte> > bytes;
+};
+
+static std::map<std::string, cached_image> imageCache;
+
+// -x for a request that gives none, so a program that never exits cannot hold its connection forever
+static const uint32_t serveMaxCycles = 100000000;
+static pthread_mutex_t requestLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static std::shared_ptr<const std::vector<byte> > cached_image_for(const char *name, const char *path)
+{
+	struct stat st;
+
+	if (stat(path, &st) != 0) {
+		throw option_error(20, std::string(name) + ": " + path + " does not exist");
+	}
+	cached_image &c = imageCache[path];
+	if (!c.bytes || c.mtime != st.st_mtime || c.size != st.st_size) {
+		std::shared_ptr<std::vector<byte> > bytes(new std::vector<byte>);
+		read_image(name, path, *bytes);
+		c.mtime = st.st_mtime;
+		c.size = st.st_size;
+		c.bytes = bytes;
+	}
+	return c.bytes;
+}
+
+
+// Parses one --serve request. getopt, strtok and the image cache are shared by every
+// connection, so the requests take turns.
+static bool prepare_request(const std::string &request, server_job &job, std::string &error)
+{
+	std::vector<char *> args(1, (char *)"request");
+	std::vector<image_files> images;
+	std::vector<const char *> lanes;
+	bool ok = true;
+
+	pthread_mutex_lock(&requestLock);
+	job.words.assign(request.begin(), request.end());
+	job.words.push_back('\0');
+	for (char *tok = strtok(&job.words[0], " \t\r\n"); tok; tok = strtok(NULL, " \t\r\n")) {
+		args.push_back(tok);
+	}
+	opterr = 0;  // getopt's complaints would go to the server's stderr, not to the client
+	try {
+		parse_options(args.size(), &args[0], job.opts, images, lanes);
+		check_job(args[0], job.opts, images, lanes);
+		if (!job.opts.maxCycles) job.opts.maxCycles = serveMaxCycles;
+		job.text = cached_image_for(args[0], images[0].text);
+		if (images[0].data) job.data = cached_image_for(args[0], images[0].data);
+	} catch (const option_error &e) {
+		error = e.message.empty() ? std::string(args[0]) + ": bad or missing options, see rsim's usage" : e.message;
+		ok = false;
+	}
+	opterr = 1;
+	pthread_mutex_unlock(&requestLock);
+	return ok;
+}
+
+
+// *****************************
+//           entry point
+// *****************************
+int32_t main(int32_t argc, char **argv)
+{
+	if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+		return run_manifest(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+		std::vector<int> cpus;
+		if (argc == 5 && strcmp(argv[3], "-a") == 0) {
+			try {
+				parse_host_cpus(*argv, argv[4], cpus);
+			} catch (const option_error &e) {
+				exit_with(e, *argv);
+			}
+		}
+		else if (argc != 3) {
+			cout << *argv << " usage: " << *argv << " --serve socket_path [-a cpus]" << endl;
+			exit(10);
+		}
+		cout << *argv << ": Serving on " << argv[2] << endl;
+		run_server(argv[2], cpus, prepare_request);
+	}
+
+	memory   mem;
+	memory  *thread2 = NULL;  // a second -t loads a second SMT thread into its own memory
+	cpu_options opts;
+	std::vector<image_files> images;
+	std::vector<const char *> lanes;
+
+	try {
+		parse_options(argc, argv, opts, images, lanes);
+		if (opts.checkpointFile) {
+			mem.track_writes();  // the checkpoint holds the pages written from here on, restored ones included
+		}
+		for (size_t x = 0; x < images.size(); x++) {
+			std::vector<byte> text, data;
+			memory *image = x ? (thread2 = new memory) : &mem;
+
+			read_image(*argv, images[x].text, text);
+			load_image(image, text, text_segment);
+			if (images[x].data) {
+				read_image(*argv, images[x].data, data);
+				load_image(image, data, data_segment);
+			}
+		}
+		for (size_t x = 0; x < lanes.size(); x++) {
+			std::vector<byte> text, data;
+			memory *lane = x ? new memory : &mem;  // lane 0 is mem, already holding .text
+
+			if (x) {
+				read_image(*argv, images[0].text, text);
+				load_image(lane, text, text_segment);
+			}
+			read_image(*argv, lanes[x], data);
+			load_image(lane, data, data_segment);
+			opts.laneImages.push_back(lane);
+		}
+	} catch (const option_error &e) {
+		exit_with(e, *argv);
+	}
+	if (opts.inputFile && !freopen(opts.inputFile, "r", stdin)) {
+		perror(opts.inputFile);
+		exit(20);
+	}
+	opts.smtImage = thread2;
 	cout << *argv << ": Starting CPU..." << endl;
-	run_cpu(&mem, verb, branchPredictor); // Added argument for the branch predictor number
+	run_cpu(&mem, opts);
 	cout << *argv << ": CPU Finished" << endl;
+	delete thread2;
+	for (size_t x = 1; x < opts.laneImages.size(); x++) {
+		delete opts.laneImages[x];
+	}
 
 	if (mem.is_collecting()) mem.display_memory_stats();
 }
@@ -2,6 +2,10 @@
 #define _LATCH_H_
 #include "instruction.h"
 #include <bitset>
+#include <deque>
+#include <vector>
+
+struct checkpoint_io;
 
 class latch {
 public:
@@ -13,7 +17,7 @@ public:
 		
 	}	
 	
-	inline const instruction *control()
+	inline const instruction *control() const
 	{
 		return &instructions[opcode];
 	}
@@ -36,6 +40,7 @@ class IDl : public latch {
 public:
 	uint32_t immediate;
 	bool predict_taken;
+	byte hint;           // static hint from the padding byte
 	uint32_t PC;
 	uint32_t recoveryPC; // Added a recovery Program Counter here
 	uint32_t bpHistory;
@@ -43,12 +48,24 @@ public:
 	uint32_t address2bit;// address of finite state machine in table for 2 bit predictor
 
 	std::bitset<10> index2level_c = 0b0000000000; // initialise a global history buffer copy , incase we mispredict
+
+	// a fetch slot made on the stack reaches predict_branch before anything writes these
+	IDl()
+	{
+		predict_taken = false;
+		hint = HINT_NONE;
+		recoveryPC = 0;
+		bpHistory = 0;
+		state2bit = 0;
+		address2bit = 0;
+	}
 };
 
 class DEl : public latch {
 public:
 	uint32_t immediate;
 	int32_t  Rsrc1Val, Rsrc2Val;
+	uint32_t PC;           // address the instruction was fetched from
 	uint32_t recoveryPC;   // Added a recovery Program Counter here
 	uint32_t state2bit;	   // State of Finite state machine
 	uint32_t address2bit;  // address of finite state machine in table for 2 bit predictor
@@ -56,8 +73,46 @@ public:
 	std::bitset<10> index2level_c = 0b0000000000; // initialise a global history buffer copy , incase we mispredict
 
 	bool predict_taken;
+	byte hint;
+	bool resolved;			// the branch was already resolved in decode (-e)
 	bool ready;				//indicate whether the data in the latch is ready or not	
+
+	// macro-op fusion (-f): the conditional branch decoded together with this addi/subi.
+	// Operands naming Rdest take the ALU result in execute; the others were read in decode.
+	bool fused;
+	IDl fusedBranch;
+	int32_t fusedSrc1Val, fusedSrc2Val;
+
+	// as for IDl: the superscalar and out-of-order models copy uops before every flag is set
+	DEl()
+	{
+		predict_taken = false;
+		hint = HINT_NONE;
+		resolved = false;
+		ready = false;
+		fused = false;
+		Rsrc1Ready = false;
+		Rsrc2Ready = false;
+	}
 	
+	// carry the decoded instruction and its prediction over from the IF/ID latch
+	void load(const IDl &l)
+	{
+		immediate = l.immediate;
+		Rsrc1 = l.Rsrc1;
+		Rsrc2 = l.Rsrc2;
+		Rdest = l.Rdest;
+		opcode = l.opcode;
+		predict_taken = l.predict_taken;
+		hint = l.hint;
+		PC = l.PC;
+		recoveryPC = l.recoveryPC;			// Carry over the recovery PC
+		state2bit = l.state2bit;			// Carry over the states of finite state machine for 2 bit predictor
+		address2bit = l.address2bit;		// Carry over address/index for 2 bit predictor
+		index2level_c = l.index2level_c;	// carry over index for 2level predictor
+		fused = false;
+	}
+
 	void setRsrc1Ready(bool _ready)
 	{
 		Rsrc1Ready=_ready;
@@ -82,14 +137,19 @@ public:
 		Rsrc2 = 0;
 		opcode = 0;
 		ready = false;
+		resolved = false;
+		fused = false;
 	}	
 	
 private:
 	bool Rsrc1Ready, Rsrc2Ready;
+
+	friend void transfer(checkpoint_io &io, DEl &l);  // checkpoint.cc
 };
 
 class EMl : public latch {
 public:
+	uint32_t PC;
 	uint32_t aluresult;
 	int32_t  Rsrc1Val, Rsrc2Val;
 };
@@ -116,17 +176,56 @@ class InstructionFetchStage: public PipelineStage {
 public:
 	cpu_core *core;
 	IDl right;
+
+	// Decoupled front end (iqDepth > 0): the predictor runs ahead filling the fetch target
+	// queue, fetch moves those into the instruction queue, and right is the queue's head.
+	int ftqDepth, iqDepth;
+	std::deque<IDl> ftq, iq;
+	std::vector<uint64_t> ftqHistogram, iqHistogram; // clocks spent at each occupancy
+	uint64_t fetchAccesses;   // instructions read from memory
+	uint64_t redirectDrops;   // queued instructions thrown away by redirects
+
+	// Loop buffer (loopEntries > 0): the body of the last short backward loop, filled on one
+	// iteration and replayed on the next ones instead of reading memory.
+	int loopEntries;
+	uint32_t loopStart, loopEnd;  // PCs of the first instruction and the backward branch
+	std::vector<IDl> loopBody;
+	std::vector<bool> loopValid;
+	uint64_t loopHits;        // instructions supplied by the loop buffer
+	uint64_t loopsCaptured;
+
 	InstructionFetchStage(cpu_core *c)
 	{
 		core = c; make_nop();
+		ftqDepth = 0;
+		iqDepth = 0;
+		fetchAccesses = 0;
+		redirectDrops = 0;
+		loopEntries = 0;
+		loopStart = 0;
+		loopEnd = 0;
+		loopHits = 0;
+		loopsCaptured = 0;
 	}
 
 
 	void Execute();
+	void Refill();
+	void SetQueues(int ftq_depth, int iq_depth);
+	void SetLoopBuffer(int entries);
+	void DisplayFetchStats();
 	void make_nop()
 	{
+		redirectDrops += ftq.size() + iq.size();
+		ftq.clear();
+		iq.clear();
 		right.reset();
 	}
+
+private:
+	void RunAhead();
+	void Fetch(uint32_t pc, IDl &latch);
+	void TrackLoop(const IDl &latch);
 };
 
 class InstructionDecodeStage: public PipelineStage {
@@ -143,6 +242,10 @@ public:
 	void Execute();
 	void Shift();
 	void make_nop();
+
+private:
+	bool EarlyOperand(byte reg, int32_t *val);
+	void TryFusion();
 };
 
 class ExecuteStage: public PipelineStage {
@@ -175,6 +278,8 @@ public:
 	cpu_core *core;
 	EMl left;
 	MWl right;
+	int busyCycles;   // clocks left on an L1 miss
+
 	MemoryStage(cpu_core *c)
 	{
 		core = c; make_nop();
@@ -186,6 +291,7 @@ public:
 	void DoForwarding();
 	void make_nop()
 	{
+		busyCycles=0;
 		right.reset();
 		left.reset();
 	}
@@ -209,4 +315,24 @@ public:
 	}
 };
 
+// Reads the instruction at pc out of memory into latch.
+void read_instruction(cpu_core *core, uint32_t pc, IDl &latch);
+
+// Branch prediction for an instruction just fetched into latch; moves core->PC on.
+void predict_branch(cpu_core *core, IDl &latch);
+
+// What the ALU makes of the instruction in l (the address, for loads).
+uint32_t alu_result(const DEl &l);
+
+// The memory stage's load or store; returns the loaded data.
+uint32_t memory_access(cpu_core *core, const instruction *control, uint32_t addr, int32_t store);
+
+// Clocks the L1 data cache adds to that access (0 without caches). Call it once per access,
+// at the point the model decides its timing.
+int cache_access(cpu_core *core, const instruction *control, uint32_t addr);
+
+// Scores and trains the branch predictor on a resolved branch, and points core->PC down the
+// right path on a mispredict. Returns true on a mispredict; the caller squashes the younger stages.
+bool resolve_branch(cpu_core *core, const DEl &branch, bool taken);
+
 #endif /* _LATCH_H_ */
@@ -0,0 +1,485 @@
+#include "superscalar.h"
+#include <assert.h>
+#include <stdio.h>
+
+superscalar_pipeline::superscalar_pipeline(cpu_core *c, const cpu_options &opts)
+{
+	core = c;
+	width = opts.width ? opts.width : 1;
+	aluPorts = opts.aluPorts ? opts.aluPorts : width;
+	memPorts = opts.memPorts ? opts.memPorts : 1;
+	scoreboard = opts.scoreboard;
+	wbPorts = opts.wbPorts ? opts.wbPorts : width;
+	depth = opts.depth ? opts.depth : 1;
+
+	// thread 0 starts from whatever run_cpu set up in core, thread 1 from its own image
+	threads.resize(opts.smtImage ? 2 : 1);
+	for (size_t t = 0; t < threads.size(); t++) {
+		hw_thread &th = threads[t];
+		th.PC = t ? text_segment : core->PC;
+		for (int x = 0; x < 32; x++) th.registers[x] = core->registers[x];
+		th.mem = t ? opts.smtImage : core->mem;
+		th.running = true;
+		th.serializing = false;
+		th.fetchResume = 0;
+		th.redirectedAt = 0;
+		for (int x = 0; x < 32; x++) {
+			th.fwdValue[x] = 0;
+			th.fwdReady[x] = 0;
+			th.fwdSeq[x] = 0;
+		}
+		th.retired = 0;
+		th.fetchClocks = 0;
+		th.finishCycle = 0;
+	}
+	current = 0;
+	fetchPolicy = opts.fetchPolicy;
+	lastFetched = threads.size() - 1;
+	issueFirst = 0;
+
+	nextSeq = 0;
+	for (int x = 0; x < FU_COUNT; x++) unitFree[x] = 0;
+
+	retired = 0;
+	issueHistogram.assign(width + 1, 0);
+	dependencyStalls = 0;
+	groupStalls = 0;
+	portStalls = 0;
+	unitStalls = 0;
+	completionStalls = 0;
+	wawStalls = 0;
+	writebackConflicts = 0;
+	redirects = 0;
+	redirectClocks = 0;
+}
+
+
+// One clock. Like run_cpu's loop for the five stage pipeline, writes happen before reads, and
+// each group of stages drains into the next before it is refilled.
+void superscalar_pipeline::cycle()
+{
+	writeback();
+	memory_stage();
+	execute();
+	issue();
+	decode();
+	fetch();
+}
+
+
+// Puts thread t's PC, registers and memory into core, saving the ones there.
+void superscalar_pipeline::use_thread(int t)
+{
+	if (t == current) {
+		return;
+	}
+	hw_thread &from = threads[current];
+	hw_thread &to = threads[t];
+
+	from.PC = core->PC;
+	from.mem = core->mem;
+	for (int x = 0; x < 32; x++) from.registers[x] = core->registers[x];
+	core->PC = to.PC;
+	core->mem = to.mem;
+	for (int x = 0; x < 32; x++) core->registers[x] = to.registers[x];
+	current = t;
+}
+
+
+void superscalar_pipeline::writeback()
+{
+	for (size_t x = 0; x < retiring.size(); x++) {
+		uop &u = retiring[x];
+		hw_thread &th = threads[u.thread];
+		const instruction *control = u.d.control();
+
+		if (!th.running) continue;
+		use_thread(u.thread);
+		if (control->special_case != NULL) {
+			control->special_case(core);
+			th.serializing = false;
+			if (!core->usermode) {
+				// this thread exited; the other one carries on
+				th.running = false;
+				th.finishCycle = core->cycles + 1;
+				th.fetched.clear();
+				th.decoded.clear();
+				core->usermode = true;
+			}
+		}
+		if (control->register_write && u.d.Rdest) {
+			core->registers[u.d.Rdest].value = control->mem_to_register ? u.mem_data : u.aluresult;
+			assert(core->registers[u.d.Rdest].lockRefCount > 0);
+			core->registers[u.d.Rdest].lockRefCount--;
+		}
+		retired++;
+		th.retired++;
+	}
+	retiring.clear();
+
+	core->usermode = false;
+	for (size_t t = 0; t < threads.size(); t++) {
+		if (threads[t].running) core->usermode = true;
+	}
+}
+
+
+void superscalar_pipeline::memory_stage()
+{
+	size_t x = 0;
+	for (; x < memacc.size() && memacc[x].memDone <= core->cycles; x++) {
+		uop &u = memacc[x];
+		hw_thread &th = threads[u.thread];
+		const instruction *control = u.d.control();
+
+		use_thread(u.thread);
+		u.mem_data = memory_access(core, control, u.aluresult, u.d.Rsrc2Val);
+		// loaded data joins the bypass network here, unless a younger write has replaced it
+		if (control->mem_read && u.d.Rdest && th.fwdSeq[u.d.Rdest] == u.seq) {
+			th.fwdValue[u.d.Rdest] = u.mem_data;
+		}
+		retiring.push_back(u);
+	}
+	memacc.erase(memacc.begin(), memacc.begin() + x);
+}
+
+
+void superscalar_pipeline::execute()
+{
+	// results were computed as the group issued; what is left is the functional unit latency.
+	if (!scoreboard) {
+		// completion is in order, which issue guarantees, so the finished uops are at the front
+		size_t done = 0;
+		while (done < executing.size() && executing[done].doneCycle <= core->cycles) {
+			enter_memory(executing[done]);
+			done++;
+		}
+		executing.erase(executing.begin(), executing.begin() + done);
+		return;
+	}
+
+	// any finished uop may leave, but only wbPorts of them get a result bus; oldest first
+	int granted = 0;
+	for (size_t x = 0; x < executing.size(); ) {
+		if (executing[x].doneCycle > core->cycles) {
+			x++;
+		}
+		else if (granted == wbPorts) {
+			writebackConflicts++;
+			x++;
+		}
+		else {
+			enter_memory(executing[x]);
+			executing.erase(executing.begin() + x);
+			granted++;
+		}
+	}
+}
+
+
+// u leaves execute for the memory sub-stages. An L1 miss keeps it there longer, along with
+// everything behind it, and a load's value only joins the bypass network once it comes out.
+void superscalar_pipeline::enter_memory(const uop &u)
+{
+	hw_thread &th = threads[u.thread];
+	byte r = u.d.Rdest;
+
+	memacc.push_back(u);
+	uop &m = memacc.back();
+	m.memDone = core->cycles + depth - 1 + cache_access(core, u.d.control(), u.aluresult);
+	if (memacc.size() > 1 && m.memDone < memacc[memacc.size() - 2].memDone) {
+		m.memDone = memacc[memacc.size() - 2].memDone;
+	}
+	if (u.d.control()->mem_read && r && th.fwdSeq[r] == u.seq) {
+		th.fwdReady[r] = m.memDone + 1;
+	}
+}
+
+
+// Value of reg for an instruction of th issuing now (th's registers are in core). Returns false
+// when it is not available yet; same_group then tells whether the producer is in the group being issued.
+bool superscalar_pipeline::operand(hw_thread &th, byte reg, int32_t *val, bool *same_group, uint64_t group_start)
+{
+	if (reg == 0) {
+		*val = 0;
+		return true;
+	}
+	if (core->registers[reg].lockRefCount == 0) {
+		*val = *(int32_t *)&core->registers[reg].value;
+		return true;
+	}
+	if (th.fwdReady[reg] <= core->cycles) {
+		*val = *(int32_t *)&th.fwdValue[reg];
+		return true;
+	}
+	*same_group = th.fwdSeq[reg] >= group_start;
+	return false;
+}
+
+
+// True if an older write to reg by thread t is still in a functional unit and would finish after
+// done. Equal finishing times are safe: writeback arbitration goes oldest first.
+bool superscalar_pipeline::write_lands_after(int t, byte reg, uint64_t done)
+{
+	for (size_t x = 0; x < executing.size(); x++) {
+		const uop &o = executing[x];
+		if (o.thread == t && o.d.control()->register_write && o.d.Rdest == reg && o.doneCycle > done) return true;
+	}
+	return false;
+}
+
+
+// True if thread t has anything past issue.
+bool superscalar_pipeline::in_flight(int t)
+{
+	for (size_t x = 0; x < executing.size(); x++) if (executing[x].thread == t) return true;
+	for (size_t x = 0; x < memacc.size(); x++) if (memacc[x].thread == t) return true;
+	for (size_t x = 0; x < retiring.size(); x++) if (retiring[x].thread == t) return true;
+	return false;
+}
+
+
+void superscalar_pipeline::squash_front_end(int t)
+{
+	threads[t].decoded.clear();
+	threads[t].fetched.clear();
+	// the branch outcome leaves the last execute sub-stage depth clocks after issue
+	threads[t].fetchResume = core->cycles + depth;
+}
+
+
+// Issue fills the width from each thread in turn; with two threads they take turns at going first.
+void superscalar_pipeline::issue()
+{
+	int issued = 0, aluUsed = 0, memUsed = 0;
+
+	for (size_t k = 0; k < threads.size() && issued < width; k++) {
+		issued += issue_thread((issueFirst + k) % threads.size(), width - issued, aluUsed, memUsed);
+	}
+	issueFirst = (issueFirst + 1) % threads.size();
+	issueHistogram[issued]++;
+}
+
+
+// In-order issue from thread t's decode latch into execute, at most room uops. Stops at the
+// first uop that cannot go.
+int superscalar_pipeline::issue_thread(int t, int room, int &aluUsed, int &memUsed)
+{
+	hw_thread &th = threads[t];
+	int issued = 0;
+
+	if (!th.running || th.decoded.empty()) {
+		return 0;
+	}
+	use_thread(t);
+	uint64_t group_start = th.decoded[0].seq;
+
+	for (size_t x = 0; x < th.decoded.size() && issued < room && !th.serializing; x++) {
+		uop &u = th.decoded[x];
+		const instruction *control = u.d.control();
+		bool is_mem = control->mem_read || control->mem_write;
+		bool is_alu = !is_mem && u.d.opcode != 0 && control->special_case == NULL && control->unit == FU_ALU;
+
+		if (control->special_case != NULL) {
+			// syscalls read and write state behind the pipeline's back: issue alone, once older work is done
+			if (issued || in_flight(t)) {
+				break;
+			}
+		}
+
+		int32_t v1, v2;
+		bool group1 = false, group2 = false;
+		bool ready1 = operand(th, u.d.Rsrc1, &v1, &group1, group_start);
+		bool ready2 = operand(th, u.d.Rsrc2, &v2, &group2, group_start);
+		if (!ready1 || !ready2) {
+			if (group1 || group2) groupStalls++;
+			else dependencyStalls++;
+			break;
+		}
+		if ((is_mem && memUsed == memPorts) || (is_alu && aluUsed == aluPorts)) {
+			portStalls++;
+			break;
+		}
+		if (control->unit != FU_ALU && unitFree[control->unit] > core->cycles) {
+			unitStalls++;
+			break;
+		}
+		uint64_t done = core->cycles + control->exe_cycles * depth;
+		if (!scoreboard && !executing.empty() && executing.back().doneCycle > done) {
+			completionStalls++;
+			break;
+		}
+		if (scoreboard && control->register_write && u.d.Rdest && core->registers[u.d.Rdest].lockRefCount &&
+		    write_lands_after(t, u.d.Rdest, done)) {
+			// results land out of order: a second write to the register may not overtake the first
+			wawStalls++;
+			break;
+		}
+		if (is_mem) memUsed++;
+		if (is_alu) aluUsed++;
+		if (control->unit != FU_ALU) {
+			// a pipelined unit still takes one instruction a clock; a blocking one is busy for its whole latency
+			int interval = functional_units[control->unit].interval;
+			unitFree[control->unit] = core->cycles + (interval > 1 ? interval * depth : 1);
+		}
+
+		u.d.Rsrc1Val = v1;
+		u.d.Rsrc2Val = v2;
+		u.aluresult = alu_result(u.d);
+		u.mem_data = 0;
+		u.doneCycle = done;
+
+		if (control->register_write && u.d.Rdest) {
+			byte r = u.d.Rdest;
+			core->registers[r].lockRefCount++;
+			th.fwdSeq[r] = u.seq;
+			th.fwdValue[r] = u.aluresult;
+			th.fwdReady[r] = control->mem_read ? ~0ULL : done; // a load's, once enter_memory knows
+		}
+		if (control->special_case != NULL) th.serializing = true;
+		executing.push_back(u);
+		issued++;
+		if (th.redirectedAt) {
+			redirects++;
+			redirectClocks += core->cycles - th.redirectedAt;
+			th.redirectedAt = 0;
+		}
+
+		if (control->branch && resolve_branch(core, u.d, branch_condition(u.d.opcode, v1, v2))) {
+			// everything younger than the branch is on the wrong path
+			squash_front_end(t);
+			th.redirectedAt = core->cycles;
+			core->branchFlushCycles += 2 * depth; // fetch and decode, plus the clocks execute took to decide
+			break;
+		}
+	}
+
+	if (core->verbose && issued) {
+		if (threads.size() > 1) printf("t%d ", t);
+		printf("0x%08x issue %d:", (unsigned)executing[executing.size() - issued].d.PC, issued);
+		for (size_t y = executing.size() - issued; y < executing.size(); y++) {
+			printf(" '%s'", executing[y].d.control()->name);
+		}
+		printf("\n");
+	}
+
+	if (!th.decoded.empty()) th.decoded.erase(th.decoded.begin(), th.decoded.begin() + issued);
+	return issued;
+}
+
+
+void superscalar_pipeline::decode()
+{
+	for (size_t t = 0; t < threads.size(); t++) {
+		hw_thread &th = threads[t];
+		size_t taken = 0;
+
+		while (th.decoded.size() < (size_t)width && taken < th.fetched.size() && th.fetched[taken].ready <= core->cycles) {
+			uop u;
+			u.d.load(th.fetched[taken].l);
+			u.d.resolved = false;
+			u.seq = nextSeq++;
+			u.thread = t;
+			th.decoded.push_back(u);
+			taken++;
+		}
+		th.fetched.erase(th.fetched.begin(), th.fetched.begin() + taken);
+	}
+}
+
+
+// The thread that fetches this clock, or -1. A thread can fetch if it is running, not waiting
+// for a redirect and has room in its fetch sub-stages. Round robin takes the next such thread
+// after the last one to fetch; ICOUNT the one with the fewest instructions in fetch and decode,
+// round robin breaking ties.
+int superscalar_pipeline::pick_fetch_thread()
+{
+	int best = -1;
+	size_t bestCount = 0;
+
+	for (size_t k = 1; k <= threads.size(); k++) {
+		int t = (lastFetched + k) % threads.size();
+		hw_thread &th = threads[t];
+		if (!th.running || core->cycles < th.fetchResume || th.fetched.size() >= (size_t)(width * depth)) {
+			continue;
+		}
+		size_t count = th.fetched.size() + th.decoded.size();
+		if (best < 0 || (fetchPolicy == FETCH_ICOUNT && count < bestCount)) {
+			best = t;
+			bestCount = count;
+		}
+		if (fetchPolicy == FETCH_ROUND_ROBIN) break;
+	}
+	return best;
+}
+
+
+void superscalar_pipeline::fetch()
+{
+	// a thread still waiting for a redirect is not picked: the redirect reaches fetch once the
+	// branch is through execute, as with the five stage pipeline
+	int t = pick_fetch_thread();
+	if (t < 0) {
+		return;
+	}
+	hw_thread &th = threads[t];
+	use_thread(t);
+	lastFetched = t;
+	th.fetchClocks++;
+
+	// one group a clock enters the first sub-stage; there is room for one group in each
+	for (int n = 0; n < width && th.fetched.size() < (size_t)(width * depth); n++) {
+		fetch_slot f;
+		read_instruction(core, core->PC, f.l);
+		predict_branch(core, f.l);
+		f.ready = core->cycles + depth - 1;
+		th.fetched.push_back(f);
+		if (f.l.predict_taken) {
+			break; // the rest of the fetch block is not on the predicted path
+		}
+	}
+}
+
+
+void superscalar_pipeline::display_stats()
+{
+	printf("stat.width: %d (alu ports %d, memory ports %d%s)\n", width, aluPorts, memPorts, scoreboard ? ", scoreboard" : "");
+	printf("stat.instructions: %llu\n", (unsigned long long)retired);
+	printf("stat.IPC: %.3f\n", core->cycles ? retired / double(core->cycles) : 0.0);
+	if (threads.size() > 1) {
+		printf("stat.threads: %d (fetch %s)\n", (int)threads.size(), fetchPolicy == FETCH_ICOUNT ? "icount" : "round robin");
+		for (size_t t = 0; t < threads.size(); t++) {
+			const hw_thread &th = threads[t];
+			uint64_t clocks = th.finishCycle ? th.finishCycle : core->cycles;
+			printf("stat.thread[%d].instructions: %llu\n", (int)t, (unsigned long long)th.retired);
+			printf("stat.thread[%d].cycles: %llu\n", (int)t, (unsigned long long)clocks);
+			printf("stat.thread[%d].IPC: %.3f\n", (int)t, clocks ? th.retired / double(clocks) : 0.0);
+			printf("stat.thread[%d].fetchClocks: %llu\n", (int)t, (unsigned long long)th.fetchClocks);
+		}
+	}
+	if (depth > 1) {
+		// nominal: the stage logic splits evenly and latches cost nothing, so the clock is depth times faster
+		printf("stat.depth: %d (%d stages)\n", depth, 3 * depth + 2);
+		printf("stat.CPI: %.3f\n", retired ? core->cycles / double(retired) : 0.0);
+		// measured: clocks from a mispredicted branch's issue to the first right-path issue
+		printf("stat.mispredictPenalty: %.2f\n", redirects ? redirectClocks / double(redirects) : 0.0);
+		printf("stat.nominalFrequencyGain: %.2fx\n", (double)depth);
+		printf("stat.nominalTime: %.1f (five stage clocks)\n", core->cycles / double(depth));
+	}
+	for (int x = 0; x <= width; x++) {
+		printf("stat.issueHistogram[%d]: %llu (%.1f%%)\n", x, (unsigned long long)issueHistogram[x]
+		      , core->cycles ? 100.0 * issueHistogram[x] / core->cycles : 0.0);
+	}
+	printf("stat.issueSlotUtilisation: %.1f%%\n", core->cycles ? 100.0 * retired / (double(core->cycles) * width) : 0.0);
+	printf("stat.dependencyStalls: %llu\n", (unsigned long long)dependencyStalls);
+	printf("stat.groupStalls: %llu\n", (unsigned long long)groupStalls);
+	printf("stat.portStalls: %llu\n", (unsigned long long)portStalls);
+	printf("stat.unitStalls: %llu\n", (unsigned long long)unitStalls);
+	if (scoreboard) {
+		printf("stat.wawStalls: %llu\n", (unsigned long long)wawStalls);
+		printf("stat.writebackConflicts: %llu\n", (unsigned long long)writebackConflicts);
+	}
+	else {
+		printf("stat.completionStalls: %llu\n", (unsigned long long)completionStalls);
+	}
+}
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <pthread.h>
 #include "syscall.h"
 #include "cpu.h"
 
@@ -27,19 +28,24 @@ static int32_t inline get_reg(char let, int32_t num)
 }
 
 
+// with several cores, only one reads stdin at a time
+static pthread_mutex_t input_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
 void sysc_op(cpu_core *cpu)
 {
 	// perform one of n syscall operations. including putc, puts, exit, etc.
-	if (cpu->verbose) printf("syscall %-2d: ", cpu->registers[get_reg('v', 0)].value);
+	if (cpu->caches) cpu->caches->wait_turn(cpu->coreId, cpu->cycles);
+	if (cpu->verbose) fprintf(cpu->console, "syscall %-2d: ", cpu->registers[get_reg('v', 0)].value);
 	switch (cpu->registers[get_reg('v', 0)].value) {
 	case 1:
 		// Print the integer contained in A0
-		printf("%d", cpu->registers[get_reg('a', 0)].value);
+		fprintf(cpu->console, "%d", cpu->registers[get_reg('a', 0)].value);
 		break;
 
 	case 4:
 		// print string starting at address contained in A0 (FIXME: this does not increment memory counters!)
-		printf("%s", (const char *)cpu->mem->crackaddr(cpu->registers[get_reg('a', 0)].value));
+		fprintf(cpu->console, "%s", (const char *)cpu->mem->crackaddr(cpu->registers[get_reg('a', 0)].value));
 		break;
 
 	case 5:
@@ -53,10 +59,12 @@ void sysc_op(cpu_core *cpu)
 		int32_t length = cpu->registers[get_reg('a', 1)].value;
 		// Do things the hard way so that memory statistics are right.
 		// (could just crackaddr and write directly, since virtual addresses are mem-mapped into this process)
-		while ((c = getchar()) && count < (length - 1)) {
+		pthread_mutex_lock(&input_lock);
+		while ((c = getc(cpu->input)) != EOF && c && count < (length - 1)) {
 			cpu->mem->set<byte>(cpu->registers[get_reg('a', 0)].value + count++, c);
 			if (c == 0x0a) break;                                           // on newline, break so that we mimic 'gets'
 		}
+		pthread_mutex_unlock(&input_lock);
 		cpu->mem->set<byte>(cpu->registers[get_reg('a', 0)].value + count++, 0); // add on null char
 	} break;
 
@@ -67,13 +75,23 @@ void sysc_op(cpu_core *cpu)
 	case 20:
 		// Extension: print the register file to screen.
 		for (int32_t x = 0; x < 16; x++) {
-			printf("$%d:\t0x%08x\t\t$%d:\t0x%08x\n", x, cpu->registers[x].value, x + 16, cpu->registers[x + 16].value);
+			fprintf(cpu->console, "$%d:\t0x%08x\t\t$%d:\t0x%08x\n", x, cpu->registers[x].value, x + 16, cpu->registers[x + 16].value);
 		}
 		break;
 
+	case 21:
+		// Extension: put this core's number (0 .. cores - 1) in V0.
+		cpu->registers[get_reg('v', 0)].value = cpu->coreId;
+		break;
+
+	case 22:
+		// Extension: put the number of cores sharing memory in V0.
+		cpu->registers[get_reg('v', 0)].value = cpu->coreCount;
+		break;
+
 	default:
 		throw "Unsupported SYSCALL was performed";
 		break;
 	}
-	printf("\n");
+	fprintf(cpu->console, "\n");
 }
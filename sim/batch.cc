@@ -0,0 +1,200 @@
+#include "batch.h"
+#include "memory.h"
+#include "placement.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <deque>
+
+using namespace std;
+
+// What a job leaves behind for its CSV row.
+struct job_result {
+	run_result   run;
+	memory_stats mem;
+};
+
+// Jobs are dealt round robin into one queue per worker. A worker takes from the front of its
+// own queue and, once that is empty, steals from the back of another's, so the workers that
+// drew short jobs take over the tail of one that drew long ones.
+struct job_queue {
+	pthread_mutex_t lock;
+	deque<int> jobs;
+};
+
+struct batch_pool;
+
+struct batch_worker {
+	batch_pool *pool;
+	int id;
+	pthread_t thread;
+	int cpu;                 // -a: the host CPU it is pinned to, or -1
+	uint64_t jobs, steals;
+	uint64_t clocks;         // simulated by its jobs
+	double busySeconds;      // host time spent in its jobs
+};
+
+struct batch_pool {
+	const vector<batch_job> *jobs;
+	vector<job_result> results;   // by job, so the CSV comes out in manifest order
+	vector<job_queue> queues;
+	vector<batch_worker> workers;
+};
+
+
+// The next job for worker id, its own first. False once every queue is empty.
+static bool take_job(batch_pool &pool, int id, int &job, bool &stolen)
+{
+	int n = pool.queues.size();
+
+	for (int k = 0; k < n; k++) {
+		job_queue &q = pool.queues[(id + k) % n];
+		pthread_mutex_lock(&q.lock);
+		if (!q.jobs.empty()) {
+			if (k == 0) {
+				job = q.jobs.front();
+				q.jobs.pop_front();
+			}
+			else {
+				job = q.jobs.back();
+				q.jobs.pop_back();
+			}
+			pthread_mutex_unlock(&q.lock);
+			stolen = k != 0;
+			return true;
+		}
+		pthread_mutex_unlock(&q.lock);
+	}
+	return false;
+}
+
+
+static void *batch_thread(void *arg)
+{
+	batch_worker &w = *(batch_worker *)arg;
+	batch_pool &pool = *w.pool;
+
+	// pinned first, so the pages of the worker's memory and core are first touched, and so
+	// allocated, on its own node
+	if (w.cpu >= 0) pin_thread(w.cpu);
+	memory *mem = new memory;
+	core_context *core = new_core_context();
+	FILE *console = fopen("/dev/null", "w");  // what the jobs print is not kept
+	int  job;
+	bool stolen;
+	timespec begin, finish;
+
+	while (take_job(pool, w.id, job, stolen)) {
+		const batch_job &j = (*pool.jobs)[job];
+		job_result &r = pool.results[job];
+		FILE *input = j.opts.inputFile ? fopen(j.opts.inputFile, "r") : NULL;
+
+		if (!input) input = fopen("/dev/null", "r");
+		clock_gettime(CLOCK_MONOTONIC, &begin);
+		mem->clear();
+		mem->load(text_segment, &(*j.text)[0], j.text->size());
+		if (j.data) mem->load(data_segment, &(*j.data)[0], j.data->size());
+		mem->collect_stats(true);
+		run_job(core, mem, j.opts, input, console, r.run);
+		r.mem = mem->stats();
+		mem->collect_stats(false);
+		clock_gettime(CLOCK_MONOTONIC, &finish);
+		fclose(input);
+		w.busySeconds += (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+		w.clocks += r.run.cycles;
+		w.jobs++;
+		if (stolen) w.steals++;
+	}
+	fclose(console);
+	delete_core_context(core);
+	delete mem;
+	return NULL;
+}
+
+
+// A CSV field in double quotes, any quotes in it doubled.
+static void write_quoted(FILE *csv, const char *s)
+{
+	fputc('"', csv);
+	for (; *s; s++) {
+		if (*s == '"') fputc('"', csv);
+		fputc(*s, csv);
+	}
+	fputc('"', csv);
+}
+
+
+void run_batch(const vector<batch_job> &jobs, int workers, const vector<int> &cpus, FILE *csv)
+{
+	batch_pool pool;
+	timespec begin, finish;
+
+	pool.jobs = &jobs;
+	pool.results.resize(jobs.size());
+	pool.queues.resize(workers);
+	pool.workers.resize(workers);
+	for (int x = 0; x < workers; x++) {
+		pthread_mutex_init(&pool.queues[x].lock, NULL);
+	}
+	for (size_t x = 0; x < jobs.size(); x++) {
+		pool.queues[x % workers].jobs.push_back(x);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	for (int x = 0; x < workers; x++) {
+		batch_worker &w = pool.workers[x];
+		w.pool = &pool;
+		w.id = x;
+		w.cpu = cpus.empty() ? -1 : cpus[x % cpus.size()];
+		w.jobs = 0;
+		w.steals = 0;
+		w.clocks = 0;
+		w.busySeconds = 0;
+		pthread_create(&w.thread, NULL, batch_thread, &w);
+	}
+	for (int x = 0; x < workers; x++) {
+		pthread_join(pool.workers[x].thread, NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	for (int x = 0; x < workers; x++) {
+		pthread_mutex_destroy(&pool.queues[x].lock);
+	}
+
+	uint64_t clocks = 0, faults = 0, limited = 0, steals = 0;
+	fprintf(csv, "line,options,status,cycles,BPHits,BPMisses,branchFlushCycles,memReads,memWrites,bytesRead,bytesWritten,stackPushes,stackPops\n");
+	for (size_t x = 0; x < jobs.size(); x++) {
+		const job_result &r = pool.results[x];
+
+		fprintf(csv, "%d,", jobs[x].line);
+		write_quoted(csv, jobs[x].options.c_str());
+		fputc(',', csv);
+		write_quoted(csv, r.run.status);
+		fprintf(csv, ",%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", r.run.cycles, r.run.BPHits, r.run.BPMisses, r.run.branchFlushCycles
+		       , r.mem.reads, r.mem.writes, r.mem.bytesRead, r.mem.bytesWritten, r.mem.pushes, r.mem.pops);
+		clocks += r.run.cycles;
+		if (strcmp(r.run.status, "limit") == 0) limited++;
+		else if (strcmp(r.run.status, "exit") != 0) faults++;
+	}
+
+	double seconds = (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+	printf("stat.batchJobs: %llu (%llu faulted, %llu stopped at -x)\n", (unsigned long long)jobs.size()
+	      , (unsigned long long)faults, (unsigned long long)limited);
+	printf("stat.batchWorkers: %d\n", workers);
+	printf("stat.batchWorkerJobs:");
+	for (int x = 0; x < workers; x++) {
+		printf(" %llu", (unsigned long long)pool.workers[x].jobs);
+		steals += pool.workers[x].steals;
+	}
+	printf("\n");
+	printf("stat.batchSteals: %llu\n", (unsigned long long)steals);
+	for (int x = 0; x < workers; x++) {
+		const batch_worker &w = pool.workers[x];
+
+		printf("stat.worker: %d\n", x);
+		if (w.cpu >= 0) printf("stat.hostCpu: %d (node %d)\n", w.cpu, cpu_node(w.cpu));
+		printf("stat.workerClocksPerSecond: %.0f\n", w.busySeconds > 0 ? w.clocks / w.busySeconds : 0.0);
+	}
+	printf("stat.hostSeconds: %.3f\n", seconds);
+	printf("stat.jobsPerSecond: %.1f\n", seconds > 0 ? jobs.size() / seconds : 0.0);
+	printf("stat.simulatedClocksPerSecond: %.0f\n", seconds > 0 ? clocks / seconds : 0.0);
+}
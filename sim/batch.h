@@ -0,0 +1,22 @@
+#ifndef _BATCH_H_
+#define _BATCH_H_
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "cpu.h"
+
+// One line of a --batch manifest: its rsim options, parsed, and the images it loads.
+struct batch_job {
+	int line;                         // in the manifest
+	std::string options;              // as written, for the CSV
+	cpu_options opts;
+	const std::vector<byte> *text;
+	const std::vector<byte> *data;    // NULL: nothing in .data
+};
+
+// Runs every job on workers host threads and writes one CSV row per job to csv, in manifest
+// order. Each worker keeps one core and one memory for all the jobs it runs; with cpus (-a),
+// worker x is pinned to cpus[x % cpus.size()] before it sets them up.
+void run_batch(const std::vector<batch_job> &jobs, int workers, const std::vector<int> &cpus, FILE *csv);
+
+#endif /* _BATCH_H_ */
@@ -0,0 +1,133 @@
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bptrace.h"
+#include "predictor.h"
+
+// Standalone branch predictor evaluator. Replays a trace written by rsim -T through
+// one or more predictors without simulating the pipeline.
+
+using namespace std;
+
+// Usage of the program
+static void usage(char *name)
+{
+	cout << name << " usage:\n" <<
+	        "\t-f trace_file: branch trace written by rsim -T\n" <<
+	        "\t-b predictors: [optional] comma separated -b numbers to replay (default 0,1,2,3,4)\n" <<
+	        "\t-r count: [optional] replay the trace count times, for timing short traces\n" << endl;
+}
+
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+// Templated on the concrete predictor so predict/update inline into the loop.
+template <class P>
+static void replay(P &p, const vector<trace_record> &trace, int repeat, uint64_t &hits, uint64_t &misses)
+{
+	const trace_record *r = trace.empty() ? NULL : &trace[0];
+	const size_t n = trace.size();
+
+	for (int pass = 0; pass < repeat; pass++) {
+		for (size_t x = 0; x < n; x++) {
+			const uint32_t pc = r[x].pc();
+			const bool taken = r[x].taken();
+			if (p.predict(pc, r[x].target, r[x].hint()) == taken) hits++;
+			else misses++;
+			p.update(pc, r[x].target, taken);
+		}
+	}
+}
+
+
+static bool run(int kind, const vector<trace_record> &trace, int repeat)
+{
+	predictor *p = make_predictor(kind);
+	uint64_t hits = 0, misses = 0;
+
+	if (!p) {
+		return false;
+	}
+
+	double start = now();
+	switch (kind) {
+	case 0: replay(*static_cast<not_taken_predictor *>(p), trace, repeat, hits, misses); break;
+	case 1: replay(*static_cast<taken_predictor *>(p), trace, repeat, hits, misses); break;
+	case 2: replay(*static_cast<twobit_predictor *>(p), trace, repeat, hits, misses); break;
+	case 3: replay(*static_cast<twolevel_predictor *>(p), trace, repeat, hits, misses); break;
+	case 4: replay(*static_cast<hint_predictor *>(p), trace, repeat, hits, misses); break;
+	default: replay(*p, trace, repeat, hits, misses); break;
+	}
+	double elapsed = now() - start;
+
+	printf("bp[%d] %-10s hits: %llu misses: %llu miss rate: %.4f  (%.1f Mbranches/s)\n"
+	      , kind, p->name(), (unsigned long long)hits, (unsigned long long)misses
+	      , (hits + misses) ? misses / double(hits + misses) : 0.0
+	      , elapsed > 0 ? (hits + misses) / elapsed / 1e6 : 0.0);
+	delete p;
+	return true;
+}
+
+
+// *****************************
+//           entry point
+// *****************************
+int32_t main(int32_t argc, char **argv)
+{
+	int32_t ch;
+	const char *tracefile = NULL;
+	const char *kinds = "0,1,2,3,4";
+	int repeat = 1;
+
+	while ((ch = getopt(argc, argv, "f:b:r:")) != -1) {
+		switch (ch) {
+		case 'f':
+			tracefile = optarg;
+			break;
+
+		case 'b':
+			kinds = optarg;
+			break;
+
+		case 'r':
+			repeat = atoi(optarg);
+			break;
+
+		default:
+			usage(*argv);
+			exit(10);
+			break;
+		}
+	}
+
+	if (!tracefile || repeat < 1) {
+		usage(*argv);
+		exit(10);
+	}
+
+	vector<trace_record> trace;
+	if (!bptrace_load(tracefile, trace)) {
+		exit(20);
+	}
+	printf("%s: %lu branches\n", tracefile, (unsigned long)trace.size());
+
+	char *list = strdup(kinds);
+	for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+		if (!run(atoi(tok), trace, repeat)) {
+			cout << *argv << ": no predictor " << tok << endl;
+			exit(10);
+		}
+	}
+	free(list);
+	return 0;
+}
@@ -0,0 +1,93 @@
+#ifndef _CACHE_H_
+#define _CACHE_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <vector>
+
+// MESI line states
+enum { LINE_INVALID = 0, LINE_SHARED, LINE_EXCLUSIVE, LINE_MODIFIED };
+
+// Clocks a data access adds to the memory stage, by where the line came from. A hit costs
+// nothing beyond the stage's own clock.
+enum {
+	LATENCY_UPGRADE = 4,   // write hit on a shared line: one bus transaction to invalidate the others
+	LATENCY_CACHE   = 10,  // miss supplied by another core's cache
+	LATENCY_MEMORY  = 30   // miss supplied by memory
+};
+
+// One private L1 data cache: tags and MESI states only, the data itself stays in memory.
+struct l1_cache {
+	struct line {
+		uint32_t tag;      // line address (addr / lineBytes)
+		int      state;
+		uint64_t lastUse;  // for LRU replacement
+	};
+	std::vector<line> lines;   // sets * ways, one set after the other
+
+	// stats
+	uint64_t reads, writes;
+	uint64_t readMisses, writeMisses;
+	uint64_t upgrades;         // writes that hit a shared line
+	uint64_t coherenceMisses;  // misses on a line another core invalidated
+	uint64_t invalidated;      // lines this cache lost to other cores' writes
+	uint64_t writebacks;       // modified lines evicted
+	uint64_t stallClocks;      // clocks added to the memory stage
+
+	l1_cache() : reads(0), writes(0), readMisses(0), writeMisses(0), upgrades(0), coherenceMisses(0),
+	             invalidated(0), writebacks(0), stallClocks(0) {}
+};
+
+// Per-line sharing history, kept for every line some core has lost to an invalidation.
+struct line_sharing {
+	std::vector<bool>     lost;     // per core: its copy was invalidated and not yet missed on
+	std::vector<uint64_t> written;  // per core: bytes other cores wrote since it was invalidated
+	uint64_t invalidations;
+	uint64_t trueSharing;           // coherence misses on bytes another core really wrote
+	uint64_t falseSharing;          // coherence misses on other bytes of the line
+
+	line_sharing() : invalidations(0), trueSharing(0), falseSharing(0) {}
+};
+
+// Private L1 data caches for every core, kept coherent by snooping a shared bus with MESI.
+// Bus transactions are atomic and happen in (clock, core) order, whichever host thread gets
+// there first (see wait_turn), so runs repeat exactly.
+class coherence_bus {
+public:
+	coherence_bus(int cores, int size, int assoc, int line_bytes);
+
+	// A load (write false) or store of size bytes by core. Returns the clocks it adds to the
+	// memory stage.
+	int access(int core, uint32_t addr, int size, bool write);
+
+	// -n: core may use the bus, memory or a syscall at clock only once every core before it
+	// has finished that clock and every core after it the one before. A core that is ahead
+	// waits at its next access, not at every clock, so the threads still run side by side.
+	void wait_turn(int core, uint64_t clock);
+	void finish_clocks(int core, uint64_t clocks);  // clocks core has finished (~0: it stopped)
+
+	void display_stats(int core);  // one core's cache
+	void display_bus_stats();      // bus traffic and the most contended lines
+
+private:
+	int sets, ways, lineBytes;
+	std::vector<l1_cache> caches;
+	std::map<uint32_t, line_sharing> sharing;
+	uint64_t useClock;
+	std::vector<uint64_t> clocksDone;  // per core, written by its own thread only
+
+	// bus transactions
+	uint64_t busReads;     // BusRd: read miss
+	uint64_t busReadXs;    // BusRdX: write miss
+	uint64_t busUpgrades;  // BusUpgr: write hit on a shared line
+	uint64_t flushes;      // modified lines supplied by their owner on a snoop
+	uint64_t transfers;    // misses supplied cache to cache
+
+	int access_line(int core, uint32_t tag, uint64_t mask, bool write);
+	l1_cache::line *find(int core, uint32_t tag);
+	l1_cache::line *victim(int core, uint32_t tag);
+	void lose(int core, uint32_t tag);
+	void note_write(int core, uint32_t tag, uint64_t mask);
+};
+
+#endif /* _CACHE_H_ */
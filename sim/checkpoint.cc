@@ -0,0 +1,368 @@
+#include "checkpoint.h"
+#include <sys/stat.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+
+// The file: this magic, the format version, the pipeline options, the core, then the memory
+// (see transfer_memory).
+static const char     checkpoint_magic[8] = { 'r', 's', 'i', 'm', 'c', 'k', 'p', 't' };
+static const uint32_t checkpoint_version = 2;
+static const uint32_t page_size = 1 << 12;
+
+
+static void transfer(checkpoint_io &io, uint64_t &value)
+{
+	io.raw(value);
+}
+
+
+static void transfer(checkpoint_io &io, std::bitset<10> &bits)
+{
+	uint32_t value = bits.to_ulong();
+	io.raw(value);
+	bits = std::bitset<10>(value);
+}
+
+
+// A vector or deque: its length, then each element.
+template <class C>
+static void transfer_all(checkpoint_io &io, C &items)
+{
+	uint32_t n = items.size();
+
+	io.raw(n);
+	if (!io.saving && io.ok) {
+		if (n > (1u << 20)) {
+			io.ok = false;  // more than the pipeline ever holds; not a checkpoint of ours
+			return;
+		}
+		items.resize(n);
+	}
+	for (typename C::iterator x = items.begin(); x != items.end() && io.ok; ++x) {
+		transfer(io, *x);
+	}
+}
+
+
+static void transfer_flags(checkpoint_io &io, std::vector<bool> &flags)
+{
+	uint32_t n = flags.size();
+
+	io.raw(n);
+	if (!io.saving && io.ok) {
+		if (n > (1u << 20)) {
+			io.ok = false;
+			return;
+		}
+		flags.assign(n, false);
+	}
+	for (uint32_t x = 0; x < n && io.ok; x++) {
+		bool flag = flags[x];
+		io.raw(flag);
+		flags[x] = flag;
+	}
+}
+
+
+static void transfer_latch(checkpoint_io &io, latch &l)
+{
+	io.raw(l.opcode);
+	if (l.opcode >= opcode_count) {
+		io.ok = false;
+	}
+	io.raw(l.Rdest);
+	io.raw(l.Rsrc1);
+	io.raw(l.Rsrc2);
+}
+
+
+static void transfer(checkpoint_io &io, IDl &l)
+{
+	transfer_latch(io, l);
+	io.raw(l.immediate);
+	io.raw(l.predict_taken);
+	io.raw(l.hint);
+	io.raw(l.PC);
+	io.raw(l.recoveryPC);
+	io.raw(l.bpHistory);
+	io.raw(l.state2bit);
+	io.raw(l.address2bit);
+	transfer(io, l.index2level_c);
+}
+
+
+// Not static: DEl names it a friend, for the operand ready flags.
+void transfer(checkpoint_io &io, DEl &l)
+{
+	transfer_latch(io, l);
+	io.raw(l.immediate);
+	io.raw(l.Rsrc1Val);
+	io.raw(l.Rsrc2Val);
+	io.raw(l.PC);
+	io.raw(l.recoveryPC);
+	io.raw(l.state2bit);
+	io.raw(l.address2bit);
+	transfer(io, l.index2level_c);
+	io.raw(l.predict_taken);
+	io.raw(l.hint);
+	io.raw(l.resolved);
+	io.raw(l.ready);
+	io.raw(l.fused);
+	transfer(io, l.fusedBranch);
+	io.raw(l.fusedSrc1Val);
+	io.raw(l.fusedSrc2Val);
+	io.raw(l.Rsrc1Ready);
+	io.raw(l.Rsrc2Ready);
+}
+
+
+static void transfer(checkpoint_io &io, EMl &l)
+{
+	transfer_latch(io, l);
+	io.raw(l.PC);
+	io.raw(l.aluresult);
+	io.raw(l.Rsrc1Val);
+	io.raw(l.Rsrc2Val);
+}
+
+
+static void transfer(checkpoint_io &io, MWl &l)
+{
+	transfer_latch(io, l);
+	io.raw(l.aluresult);
+	io.raw(l.mem_data);
+	io.raw(l.Rsrc2Val);
+	io.raw(l.Rsrc1Val);
+}
+
+
+static void transfer_stage(checkpoint_io &io, PipelineStage &s)
+{
+	io.raw(s.OBF);
+	io.raw(s.IBF);
+}
+
+
+static void transfer(checkpoint_io &io, InstructionFetchStage &s)
+{
+	transfer_stage(io, s);
+	transfer(io, s.right);
+	io.raw(s.ftqDepth);
+	io.raw(s.iqDepth);
+	transfer_all(io, s.ftq);
+	transfer_all(io, s.iq);
+	transfer_all(io, s.ftqHistogram);
+	transfer_all(io, s.iqHistogram);
+	io.raw(s.fetchAccesses);
+	io.raw(s.redirectDrops);
+	io.raw(s.loopEntries);
+	io.raw(s.loopStart);
+	io.raw(s.loopEnd);
+	transfer_all(io, s.loopBody);
+	transfer_flags(io, s.loopValid);
+	io.raw(s.loopHits);
+	io.raw(s.loopsCaptured);
+}
+
+
+static void transfer(checkpoint_io &io, cpu_core &core)
+{
+	io.raw(core.PC);
+	io.raw(core.cycles);
+	io.raw(core.BPHits);
+	io.raw(core.BPMisses);
+	io.raw(core.hintOverrides);
+	io.raw(core.branchFlushCycles);
+	io.raw(core.earlyBranchStalls);
+	io.raw(core.earlyBranchForwards);
+	io.raw(core.loadUseStalls);
+	io.raw(core.fusedPairs);
+	io.raw(core.syscallsInFlight);
+	io.raw(core.table2bit);
+	transfer(io, core.index2level);
+	io.raw(core.usermode);
+	for (int r = 0; r < 32; r++) {
+		io.raw(core.registers[r].lockRefCount);
+		io.raw(core.registers[r].value);
+	}
+
+	transfer(io, core.ifs);
+	transfer_stage(io, core.ids);
+	transfer(io, core.ids.left);
+	transfer(io, core.ids.right);
+	transfer_stage(io, core.exs);
+	transfer(io, core.exs.left);
+	transfer(io, core.exs.right);
+	io.raw(core.exs.busyCycles);
+	transfer_stage(io, core.mys);
+	transfer(io, core.mys.left);
+	transfer(io, core.mys.right);
+	io.raw(core.mys.busyCycles);
+	transfer_stage(io, core.wbs);
+	transfer(io, core.wbs.left);
+}
+
+
+// The options start_core sets the core up from, which the rest of the checkpoint assumes.
+static void transfer_options(checkpoint_io &io, cpu_options &opts)
+{
+	io.raw(opts.branchPredictor);
+	io.raw(opts.hintOverride);
+	io.raw(opts.earlyBranch);
+	io.raw(opts.fusion);
+	io.raw(opts.iqDepth);
+	io.raw(opts.ftqDepth);
+	io.raw(opts.loopBuffer);
+}
+
+
+// Maps each run of neighbouring pages straight from the file, copy-on-write, so a restore
+// costs one mmap per run and the host reads a page in only when the program touches it. Hosts
+// with another page size read the pages in instead.
+static bool restore_pages(FILE *f, off_t start, const std::vector<uint32_t> &pages, memory *m)
+{
+	int  fd = fileno(f);
+	bool mappable = sysconf(_SC_PAGESIZE) == page_size;
+	struct stat st;
+	byte page[page_size];
+
+	if (fstat(fd, &st) != 0 || (!pages.empty() && st.st_size < start + (off_t)pages.size() * page_size)) {
+		return false;
+	}
+	for (size_t x = 0; x < pages.size(); ) {
+		size_t n = 1;
+		while (x + n < pages.size() && pages[x + n] == pages[x] + n) {
+			n++;
+		}
+		uint32_t addr = pages[x] * page_size;
+		off_t offset = start + (off_t)x * page_size;
+		if (mappable) {
+			if (!m->map_file(addr, n * page_size, fd, offset)) {
+				perror("mmap");
+				return false;
+			}
+		}
+		else {
+			for (size_t y = 0; y < n; y++) {
+				if (pread(fd, page, page_size, offset + y * page_size) != (ssize_t)page_size) {
+					return false;
+				}
+				m->load(addr + y * page_size, page, page_size);
+			}
+		}
+		x += n;
+	}
+	return true;
+}
+
+
+// The stack pointer and the list of written pages, then, from the next page boundary in the
+// file, the pages themselves in list order. The list is sorted, so pages that are neighbours
+// in memory are neighbours in the file too.
+static void transfer_memory(checkpoint_io &io, memory *m)
+{
+	int32_t sp = m->stack_top();
+	std::vector<uint32_t> pages;
+
+	io.raw(sp);
+	if (io.saving) {
+		pages = m->written_pages();
+		std::sort(pages.begin(), pages.end());
+	}
+	else {
+		m->set_stack_top(sp);
+	}
+	uint32_t n = pages.size();
+	io.raw(n);
+	if (!io.saving && io.ok) {
+		pages.resize(n);
+	}
+	if (n && io.ok) {
+		// one call for the whole list, which runs to a million entries for a 4 GiB guest
+		if (io.saving) io.ok = fwrite(&pages[0], sizeof(uint32_t), n, io.file) == n;
+		else io.ok = fread(&pages[0], sizeof(uint32_t), n, io.file) == n;
+	}
+	if (!io.ok) {
+		return;
+	}
+
+	off_t start = (ftello(io.file) + page_size - 1) / page_size * page_size;
+	if (!io.saving) {
+		io.ok = restore_pages(io.file, start, pages, m);
+		return;
+	}
+	io.ok = fseeko(io.file, start, SEEK_SET) == 0;  // the gap reads as zeros
+	for (size_t x = 0; x < pages.size() && io.ok; x++) {
+		io.ok = fwrite(m->crackaddr(pages[x] * page_size), page_size, 1, io.file) == 1;
+	}
+}
+
+
+// Written under another name and renamed over path at the end, since the pages of a restored
+// run may still be mapped from the checkpoint being replaced.
+bool save_checkpoint(const char *path, const cpu_options &opts, cpu_core &core, memory *m)
+{
+	std::string temp = std::string(path) + ".tmp";
+	checkpoint_io io = { fopen(temp.c_str(), "wb"), true, true };
+	cpu_options o = opts;
+	uint32_t version = checkpoint_version;
+
+	if (!io.file) {
+		perror(temp.c_str());
+		return false;
+	}
+	io.ok = fwrite(checkpoint_magic, sizeof(checkpoint_magic), 1, io.file) == 1;
+	io.raw(version);
+	transfer_options(io, o);
+	transfer(io, core);
+	transfer_memory(io, m);
+	if (fclose(io.file) != 0) {
+		io.ok = false;
+	}
+	if (io.ok && rename(temp.c_str(), path) != 0) {
+		io.ok = false;
+	}
+	if (!io.ok) {
+		perror(path);
+		unlink(temp.c_str());
+	}
+	return io.ok;
+}
+
+
+FILE *open_checkpoint(const char *path, cpu_options &opts)
+{
+	checkpoint_io io = { fopen(path, "rb"), false, true };
+	char     magic[sizeof(checkpoint_magic)];
+	uint32_t version = 0;
+
+	if (!io.file) {
+		perror(path);
+		return NULL;
+	}
+	io.ok = fread(magic, sizeof(magic), 1, io.file) == 1;
+	io.raw(version);
+	transfer_options(io, opts);
+	if (!io.ok || memcmp(magic, checkpoint_magic, sizeof(magic)) != 0 || version != checkpoint_version) {
+		printf("%s: not an rsim checkpoint\n", path);
+		fclose(io.file);
+		return NULL;
+	}
+	return io.file;
+}
+
+
+bool restore_checkpoint(FILE *f, const char *path, cpu_core &core, memory *m)
+{
+	checkpoint_io io = { f, false, true };
+
+	transfer(io, core);
+	transfer_memory(io, m);
+	fclose(f);
+	if (!io.ok) {
+		printf("%s: checkpoint cut short\n", path);
+	}
+	return io.ok;
+}
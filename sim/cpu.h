@@ -3,6 +3,12 @@
 #include "memory.h"
 #include "instruction.h"
 #include "stages.h"
+#include "profile.h"
+#include "bptrace.h"
+#include "predictor.h"
+#include "cache.h"
+#include <stdio.h>
+#include <vector>
 
 struct RegisterStruct
 {
@@ -15,21 +21,134 @@ struct RegisterStruct
 	}
 };
 
+// SMT fetch policies (-i)
+enum { FETCH_ROUND_ROBIN = 0, FETCH_ICOUNT };
+
+// -Y: what one child forked from the warmed core (-y) changes before it carries on.
+struct what_if {
+	const char *label;        // the -Y text, for the report
+	int  branchPredictor;
+	bool hintOverride;
+	int  cacheSize, cacheAssoc, cacheLine; // a cache unlike the parent's starts cold
+	const char *inputFile;    // syscall 8 reads the rest of its input from here (NULL: the parent's)
+	uint32_t maxCycles;
+};
+
+// Knobs handed to the simulator from the command line.
+struct cpu_options {
+	bool verbose;
+	int  branchPredictor;
+	int  profileTop;          // number of branches in the misprediction report (-1: no report)
+	int  loadUseTop;          // number of loads in the load-use stall report (-1: no report)
+	const char *profileCsv;   // [optional] dump every branch record to this file
+	const char *traceFile;    // [optional] write every resolved branch here, for bpsim
+	const char *inputFile;    // [optional] syscall 8 reads this file instead of stdin
+	std::vector<int> shadowPredictors; // -b numbers scored alongside the one driving fetch
+	bool hintOverride;        // let static hints decide weakly biased -b 2/3 predictions
+	bool earlyBranch;         // resolve branches in decode instead of execute
+	bool fusion;              // fuse addi/subi with a following dependent branch in decode
+	int  iqDepth;             // decoupled front end instruction queue entries (0: fetch straight into ID)
+	int  ftqDepth;            // fetch target queue entries (0: same as iqDepth)
+	int  loopBuffer;          // loop buffer entries in the fetch stage (0: off)
+	int  depth;               // -k: sub-stages per fetch, execute and memory stage (0: no -k, one in the superscalar model)
+	int  width;               // instructions per clock in the superscalar model (0: five stage pipeline)
+	int  aluPorts, memPorts;  // superscalar issue ports (0: width ALUs, one memory port)
+	bool scoreboard;          // superscalar: complete out of order, CDC 6600 style
+	int  wbPorts;             // superscalar scoreboard writeback ports (0: width)
+	int  robSize;             // reorder buffer entries for the out-of-order model (0: in-order)
+	int  rsSize;              // reservation station entries (0: half the ROB)
+	memory *smtImage;         // text and data of a second hardware thread (NULL: one thread)
+	int  fetchPolicy;         // which SMT thread fetches each clock
+	std::vector<memory *> laneImages; // -D: one memory per lane of the functional lockstep model (empty: off)
+	int  cores;               // cores sharing memory, each on its own host thread (1: one core)
+	uint32_t quantum;         // clocks each core runs between barriers with several cores
+	int  cacheSize;           // bytes in each core's L1 data cache (0: no caches, every access hits)
+	int  cacheAssoc, cacheLine;
+	uint32_t maxCycles;       // stop a core after this many clocks (0: run to its exit syscall)
+	uint32_t forkAt;          // clock to fork the what-ifs at (0: no forking)
+	std::vector<what_if> whatIfs;
+	const char *checkpointFile; // [optional] write the core and memory here when -x stops the core
+	const char *restoreFile;    // [optional] carry on from this checkpoint instead of loading .text
+	std::vector<int> hostCpus;  // -a: host CPUs the threads are pinned to, thread x to [x % size] (empty: not pinned)
+
+	cpu_options()
+	{
+		verbose = false;
+		branchPredictor = 0;
+		profileTop = -1;
+		loadUseTop = -1;
+		profileCsv = NULL;
+		traceFile = NULL;
+		inputFile = NULL;
+		hintOverride = false;
+		earlyBranch = false;
+		fusion = false;
+		iqDepth = 0;
+		ftqDepth = 0;
+		loopBuffer = 0;
+		depth = 0;
+		width = 0;
+		aluPorts = 0;
+		memPorts = 0;
+		scoreboard = false;
+		wbPorts = 0;
+		robSize = 0;
+		rsSize = 0;
+		smtImage = NULL;
+		fetchPolicy = FETCH_ROUND_ROBIN;
+		cores = 1;
+		quantum = 1000;
+		cacheSize = 0;
+		cacheAssoc = 0;
+		cacheLine = 0;
+		maxCycles = 0;
+		forkAt = 0;
+		checkpointFile = NULL;
+		restoreFile = NULL;
+	}
+};
+
+// A predictor that is trained and scored on every resolved branch but never steers fetch.
+struct shadow_predictor {
+	int kind;
+	predictor *model;
+	uint32_t BPHits;
+	uint32_t BPMisses;
+};
+
 // Register machine core state.
 class cpu_core {
 public:
-	cpu_core() : ifs(this), ids(this), exs(this), mys(this), wbs(this) {}
+	cpu_core() : profile(NULL), trace(NULL), loadUse(NULL), caches(NULL), ifs(this), ids(this), exs(this), mys(this), wbs(this) {}
 
 	uint32_t PC;
 	uint32_t cycles;
 	uint32_t BPHits; 
 	uint32_t BPMisses; 
 	int branchPredictor;
+	bool hintOverride;
+	uint32_t hintOverrides; // predictions a static hint turned around
+	bool earlyBranch;
+	uint32_t branchFlushCycles;   // pipeline slots squashed by mispredicts
+	uint32_t earlyBranchStalls;   // cycles a branch waited in decode for its operands (-e)
+	uint32_t earlyBranchForwards; // branch operands forwarded from the memory stage (-e)
+	uint32_t loadUseStalls;       // bubbles between a load and the instruction using its result
+	bool fusion;
+	uint32_t fusedPairs;          // addi/subi + branch pairs decoded as one op (-f)
+	uint32_t syscallsInFlight;    // decoded but not written back; they may return a value in $v0
 	int table2bit[1024] = {0}; // initialise table which contains all finite state machine states, initially all 0
 	std::bitset<10> index2level = 0b0000000000; // initialise global history buffer called index2level
 
 	bool usermode, verbose;
+	int coreId, coreCount;   // this core's number and how many share mem (syscalls 21 and 22)
+	FILE *console;           // where syscalls print
+	FILE *input;             // where syscall 8 reads
 	memory  *mem;
+	branch_profile *profile; // per-static-branch records, NULL unless asked for
+	bptrace_writer *trace;   // branch outcome trace, NULL unless asked for
+	load_use_profile *loadUse; // load-use bubbles per load, NULL unless asked for
+	coherence_bus *caches;   // L1 data caches shared with the other cores, NULL unless asked for
+	std::vector<shadow_predictor> shadows;
 	//uint32_t registers[32];
 	RegisterStruct registers[32];
 	InstructionFetchStage  ifs;
@@ -40,6 +159,38 @@ public:
 
 };
 
-void run_cpu(memory *m, const bool verbose, const int branchPredictor); // added variable for branch predictor #
+void run_cpu(memory *m, const cpu_options &opts);
+
+// How a job ended, and its headline numbers.
+struct run_result {
+	const char *status;      // "exit", "limit" (-x) or the CPU fault
+	uint32_t cycles;
+	uint32_t BPHits;
+	uint32_t BPMisses;
+	uint32_t branchFlushCycles;
+};
+
+// A core that a --batch worker, a --serve connection or a librsim simulator keeps for all of
+// its jobs.
+struct core_context;
+core_context *new_core_context();
+void delete_core_context(core_context *c);
+
+// Starts the program already loaded in m on c, from a clean core. A job still open on c is
+// ended first.
+void start_job(core_context *c, memory *m, const cpu_options &opts, FILE *input, FILE *console);
+
+// Runs up to clocks more clocks of the open job (0: until it stops) and fills r. False once
+// the job has stopped; r.status is NULL until then.
+bool step_job(core_context *c, uint32_t clocks, run_result &r);
+
+// Ends the open job, if any, and frees what it set up.
+void end_job(core_context *c);
+
+// The core running the job, for its registers and counters.
+const cpu_core &job_core(const core_context *c);
+
+// Runs the program already loaded in m on c, from a clean core, with no reports.
+void run_job(core_context *c, memory *m, const cpu_options &opts, FILE *input, FILE *console, run_result &r);
 
 #endif /* _CPU_H_ */
@@ -0,0 +1,212 @@
+#include "lanes.h"
+#include "syscall.h"
+#include <stdlib.h>
+#include <time.h>
+
+lockstep_lanes::lockstep_lanes(const std::vector<memory *> &lane_images, const cpu_options &opts)
+{
+	lanes = lane_images.size();
+	images = lane_images;
+	maxSteps = opts.maxCycles;
+	for (int r = 0; r < 32; r++) {
+		regs[r] = lane_vector{};
+	}
+	for (int l = 0; l < MAX_LANES; l++) {
+		PC[l] = text_segment;
+		running[l] = l < lanes;
+		fault[l] = NULL;
+		console[l] = l < lanes ? open_memstream(&consoleBuffer[l], &consoleSize[l]) : NULL;
+		executed[l] = 0;
+	}
+	scratch.usermode = true;
+	scratch.verbose = false;
+	scratch.coreCount = lanes;
+	scratch.input = stdin;
+	steps = 0;
+	divergentBranches = 0;
+	seconds = 0;
+}
+
+
+lockstep_lanes::~lockstep_lanes()
+{
+	for (int l = 0; l < lanes; l++) {
+		fclose(console[l]);
+		free(consoleBuffer[l]);
+	}
+}
+
+
+// Runs one lane's syscall through the pipelines' own sysc_op.
+void lockstep_lanes::syscall(int l)
+{
+	for (int r = 0; r < 32; r++) {
+		scratch.registers[r].value = regs[r][l];
+	}
+	scratch.mem = images[l];
+	scratch.console = console[l];
+	scratch.coreId = l;
+	scratch.usermode = true;
+	try {
+		sysc_op(&scratch);
+	} catch (const char *e) {
+		fault[l] = e;
+		running[l] = false;
+		return;
+	}
+	for (int r = 1; r < 32; r++) {
+		regs[r][l] = scratch.registers[r].value;
+	}
+	running[l] = scratch.usermode;
+}
+
+
+// Built twice, for AVX2 and for the baseline instruction set; the loader picks the one the
+// host can run.
+__attribute__((target_clones("avx2", "default")))
+void lockstep_lanes::run()
+{
+	timespec begin, finish;
+
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	for (;;) {
+		uint32_t at = ~0u;
+		for (int l = 0; l < lanes; l++) {
+			if (running[l] && PC[l] < at) at = PC[l];
+		}
+		if (at == ~0u || (maxSteps && steps >= maxSteps)) {
+			break;
+		}
+
+		lane_vector mask = lane_vector{};
+		int first = -1;
+		for (int l = 0; l < lanes; l++) {
+			if (running[l] && PC[l] == at) {
+				mask[l] = ~0u;
+				executed[l]++;
+				if (first < 0) first = l;
+			}
+		}
+		steps++;
+
+		memory  *text = images[first];
+		byte     opcode = text->get<byte>(at);
+		uint16_t operands = text->get<uint16_t>(at + 1);
+		uint32_t immediate = text->get<uint32_t>(at + 3);
+		byte     rd = operands & 0x1f;
+		byte     rs1 = (operands >> 5) & 0x1f;
+		byte     rs2 = (operands >> 10) & 0x1f;
+		if (opcode >= opcode_count) {
+			for (int l = 0; l < lanes; l++) {
+				if (!mask[l]) continue;
+				fault[l] = "Illegal instruction";
+				running[l] = false;
+			}
+			continue;
+		}
+		const instruction *control = &instructions[opcode];
+		lane_vector next = lane_vector{} + (at + 8);
+
+		if (control->special_case) {
+			for (int l = 0; l < lanes; l++) {
+				if (mask[l]) syscall(l);
+			}
+		}
+		else if (control->branch) {
+			lane_svector a = (lane_svector)regs[rs1], b = (lane_svector)regs[rs2];
+			lane_vector taken;
+			if (opcode == 2) taken = (lane_vector)(a == 0);
+			else if (opcode == 3) taken = (lane_vector)(a >= b);
+			else taken = (lane_vector)(a != b);
+			taken &= mask;
+
+			bool some = false, all = true;
+			for (int l = 0; l < lanes; l++) {
+				if (!mask[l]) continue;
+				if (taken[l]) some = true;
+				else all = false;
+			}
+			if (some && !all) divergentBranches++;
+			next = (taken & immediate) | (~taken & next);
+		}
+		else if (control->mem_read || control->mem_write) {
+			lane_vector addr = regs[rs1] + immediate;
+			for (int l = 0; l < lanes; l++) {
+				if (!mask[l]) continue;
+				memory *m = images[l];
+				uint32_t data = 0;
+				if (control->mem_read == 1) data = m->get<byte>(addr[l]);
+				else if (control->mem_read == 4) data = m->get<uint32_t>(addr[l]);
+				else if (control->mem_write == 1) m->set<byte>(addr[l], regs[rs2][l]);
+				else if (control->mem_write == 4) m->set<uint32_t>(addr[l], regs[rs2][l]);
+				if (control->register_write && rd) regs[rd][l] = data;
+			}
+		}
+		else {
+			// the ALU, for all lanes at once
+			lane_vector a = regs[rs1];
+			lane_vector param = control->alu_source == 0 ? regs[rs2] : lane_vector{} + immediate;
+			lane_vector result = param;
+
+			switch (control->alu_operation) {
+			case 1:
+				result = a + param;
+				break;
+
+			case 2:
+				result = a - param;
+				break;
+
+			case 3:
+				result = a * param;
+				break;
+
+			case 4:
+			case 5: {
+				// no SIMD divide; the lanes take turns with the pipelines' ALU
+				DEl l;
+				l.opcode = opcode;
+				l.immediate = immediate;
+				for (int x = 0; x < lanes; x++) {
+					if (!mask[x]) continue;
+					l.Rsrc1Val = a[x];
+					l.Rsrc2Val = param[x];
+					result[x] = alu_result(l);
+				}
+			} break;
+			}
+			if (control->register_write && rd) {
+				regs[rd] = (result & mask) | (regs[rd] & ~mask);
+			}
+		}
+
+		for (int l = 0; l < lanes; l++) {
+			if (mask[l]) PC[l] = next[l];
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	seconds = (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+}
+
+
+void lockstep_lanes::display_stats()
+{
+	uint64_t total = 0;
+
+	for (int l = 0; l < lanes; l++) {
+		fflush(console[l]);
+		printf("stat.lane: %d\n", l);
+		fwrite(consoleBuffer[l], 1, consoleSize[l], stdout);
+		if (fault[l]) printf("CPU fault: %s\n", fault[l]);
+		else if (running[l]) printf("CPU stopped at the -x limit of %u steps\n", maxSteps);
+		printf("stat.laneInstructions: %llu\n", (unsigned long long)executed[l]);
+		total += executed[l];
+	}
+	printf("stat.lanes: %d\n", lanes);
+	printf("stat.lockstepSteps: %llu\n", (unsigned long long)steps);
+	printf("stat.laneInstructions: %llu\n", (unsigned long long)total);
+	printf("stat.laneUtilization: %.1f%%\n", steps ? 100.0 * total / (steps * lanes) : 0.0);
+	printf("stat.divergentBranches: %llu\n", (unsigned long long)divergentBranches);
+	printf("stat.hostSeconds: %.3f\n", seconds);
+	printf("stat.laneInstructionsPerSecond: %.0f\n", seconds > 0 ? total / seconds : 0.0);
+}
@@ -0,0 +1,100 @@
+#include "librsim.h"
+
+// A job that has not run a clock yet.
+static run_result no_clocks(const char *status)
+{
+	run_result r = { status, 0, 0, 0, 0 };
+	return r;
+}
+
+
+simulator::simulator()
+{
+	context = new_core_context();
+	noInput = fopen("/dev/null", "r");
+	noConsole = fopen("/dev/null", "w");
+	started = false;
+	result = no_clocks("exit");
+	mem.clear();  // starts keeping track of the pages written, for reset()
+}
+
+
+simulator::~simulator()
+{
+	delete_core_context(context);
+	fclose(noInput);
+	fclose(noConsole);
+}
+
+
+void simulator::load_text(const byte *bytes, size_t size)
+{
+	mem.load(text_segment, bytes, size);
+}
+
+
+void simulator::load_data(const byte *bytes, size_t size)
+{
+	mem.load(data_segment, bytes, size);
+}
+
+
+void simulator::start(const cpu_options &opts, FILE *input, FILE *console)
+{
+	start_job(context, &mem, opts, input ? input : noInput, console ? console : noConsole);
+	mem.collect_stats(true);
+	started = true;
+	result = no_clocks(NULL);
+}
+
+
+bool simulator::step(uint32_t clocks)
+{
+	if (!started || !clocks) {
+		return started && result.status == NULL;
+	}
+	return step_job(context, clocks, result);
+}
+
+
+run_result simulator::run()
+{
+	if (started) {
+		step_job(context, 0, result);
+	}
+	return result;
+}
+
+
+void simulator::reset()
+{
+	end_job(context);
+	mem.collect_stats(false);
+	mem.clear();
+	started = false;
+	result = no_clocks("exit");
+}
+
+
+const char *simulator::status()
+{
+	return result.status;
+}
+
+
+run_result simulator::counters()
+{
+	return result;
+}
+
+
+memory_stats simulator::memory_counters()
+{
+	return mem.stats();
+}
+
+
+const cpu_core &simulator::core()
+{
+	return job_core(context);
+}
@@ -9,9 +9,10 @@
 using namespace std;
 
 
+// Private, so a fork (-y) copies pages only as one side writes them.
 memory::memory()
 {
-	mem = (byte *)mmap(NULL, 0x100000000, PROT_READ | PROT_WRITE, MAP_ANON | MAP_SHARED, -1, 0);
+	mem = (byte *)mmap(NULL, 0x100000000, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
 	if (mem == MAP_FAILED) {
 		perror("mmap failed to allocate simulator ram");
 		exit(20);
@@ -34,6 +35,54 @@ memory::~memory()
 }
 
 
+void memory::track_writes()
+{
+	written.resize(0x100000000ULL >> 18);
+}
+
+
+// The pages count as written (with track_writes), though the host reads them in only when they
+// are first touched.
+bool memory::map_file(uint32_t addr, size_t size, int fd, off_t offset)
+{
+	if (mmap(mem + addr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE, fd, offset) == MAP_FAILED) {
+		return false;
+	}
+	for (size_t x = 0; x < size && !written.empty(); x += 1 << 12) {
+		note_write(addr + x, 1);
+	}
+	return true;
+}
+
+
+void memory::clear()
+{
+	track_writes();
+	for (size_t x = 0; x < writtenPages.size(); x++) {
+		uint32_t p = writtenPages[x];
+		memset(mem + ((uint64_t)p << 12), 0, 1 << 12);
+		written[p >> 6] = 0;
+	}
+	writtenPages.clear();
+	sp = stack_segment;
+	readhits = 0;
+	writehits = 0;
+	bytesin = 0;
+	bytesout = 0;
+	stackpushes = 0;
+	stackpops = 0;
+}
+
+
+void memory::load(uint32_t addr, const byte *bytes, size_t size)
+{
+	if (size) {
+		note_write(addr, size);
+		memcpy(crackaddr(addr), bytes, size);
+	}
+}
+
+
 void memory::display_stack()
 {
 	cout << "-----stack-----" << endl;
@@ -52,6 +101,13 @@ bool memory::is_collecting()
 }
 
 
+memory_stats memory::stats()
+{
+	memory_stats s = { readhits, writehits, bytesout, bytesin, stackpushes, stackpops };
+	return s;
+}
+
+
 void memory::collect_stats(bool state)
 {
 	collectstats = state;
@@ -2,6 +2,7 @@
 #define _MEMORY_H_
 #include <sys/types.h>
 #include <string.h>
+#include <vector>
 #include "types.h"
 
 // some constants that are memory-specific
@@ -13,6 +14,11 @@ const uint32_t stack_segment = 0x80000000 - 0x1000;
 // ^ stack grows down, this is the bottom-most element (reserved space for catching errors)
 // mmap supports growing down, so all is well.
 
+// What collect_stats counted.
+struct memory_stats {
+	uint32_t reads, writes, bytesRead, bytesWritten, pushes, pops;
+};
+
 class memory {
 	// pointers to the various system segments.
 
@@ -22,6 +28,25 @@ class memory {
 
 	bool collectstats;
 
+	// The 4 KiB pages written since the last clear(), as a bitmap and as a list. Only kept once
+	// track_writes() or clear() has been called, since -n cores write to one memory from
+	// several threads.
+	std::vector<uint64_t> written;
+	std::vector<uint32_t> writtenPages;
+
+	inline void note_write(uint32_t addr, uint32_t size)
+	{
+		if (written.empty()) {
+			return;
+		}
+		for (uint32_t p = addr >> 12; p <= (addr + size - 1) >> 12; p++) {
+			if (!(written[p >> 6] & (1ULL << (p & 63)))) {
+				written[p >> 6] |= 1ULL << (p & 63);
+				writtenPages.push_back(p);
+			}
+		}
+	}
+
 	uint32_t readhits, writehits, bytesin, bytesout, stackpushes, stackpops;
 
 public:
@@ -29,6 +54,16 @@ public:
 	memory();
 	~memory();
 
+	// Back to all zero bytes, an empty stack and no stats, for the next --batch or --serve job.
+	// Only the pages written since are zeroed, and they stay mapped for the next job.
+	void clear();
+	void load(uint32_t addr, const byte *bytes, size_t size);  // copies an image in
+	void track_writes();
+	bool map_file(uint32_t addr, size_t size, int fd, off_t offset);  // copy-on-write, read in as touched
+	const std::vector<uint32_t> &written_pages() { return writtenPages; }
+	int32_t stack_top() { return sp; }
+	void set_stack_top(int32_t top) { sp = top; }
+
 	byte *crackaddr(uint32_t addr);
 
 	void display_stack();
@@ -36,10 +71,12 @@ public:
 	void collect_stats(bool val);
 	void display_memory_stats();
 	bool is_collecting();
+	memory_stats stats();
 
 	template <class T>
 	void push_stack(T value)
 	{
+		note_write(sp, sizeof(T));
 		memcpy(crackaddr(sp), &value, sizeof(T));
 		sp -= sizeof(T);
 		if (collectstats) {
@@ -80,9 +117,21 @@ public:
 	}
 
 
+	// get without counting the read, for what the simulator looks at but the program does not
+	template <class T>
+	T peek(uint32_t addr)
+	{
+		T ret;
+
+		memcpy(&ret, crackaddr(addr), sizeof(T));
+		return ret;
+	}
+
+
 	template <class T>
 	void set(uint32_t addr, T value)
 	{
+		note_write(addr, sizeof(T));
 		memcpy(crackaddr(addr), &value, sizeof(T));
 		if (collectstats) {
 			writehits++;
@@ -0,0 +1,72 @@
+#ifndef _OOO_H_
+#define _OOO_H_
+#include <vector>
+#include "cpu.h"
+
+// One reorder buffer entry. Operands come from the architectural registers, a finished
+// older entry, or arrive later by tag when the producer completes.
+struct rob_entry {
+	DEl      d;            // decoded fields and the prediction; Rsrc1Val/Rsrc2Val once ready
+	uint64_t seq;          // program order
+	int      tag1, tag2;   // ROB index of the producer still in flight, -1 once the value is in d
+	bool     issued;
+	bool     done;         // result written back, dependents woken
+	bool     taken;        // branch outcome, valid once done
+	uint32_t result;       // ALU result, or the loaded value for loads
+	uint64_t completeCycle;
+};
+
+// An out-of-order core: in-order fetch and rename into a reorder buffer, a unified
+// reservation station from which the oldest ready instructions issue, and in-order commit
+// into cpu_core::registers. Branches are resolved through resolve_branch in program order
+// (a branch waits for older ones), so wrong-path branches never train the predictor.
+// Syscalls and stores act at commit; a syscall also holds rename until it has committed.
+class ooo_pipeline {
+public:
+	ooo_pipeline(cpu_core *c, const cpu_options &opts);
+
+	void cycle();
+	void display_stats();
+
+private:
+	cpu_core *core;
+	int width;
+	int aluPorts, memPorts;
+
+	std::vector<IDl> fetched;
+	std::vector<rob_entry> rob;  // circular, robSize entries
+	int robHead, robCount;
+	std::vector<int> rs;         // ROB indices waiting to issue, at most rsSize
+	size_t rsSize;
+	int renameMap[32];           // ROB index of the youngest producer of each register, -1: registers[]
+	uint64_t nextSeq;
+	bool serializing;            // a syscall is in the ROB
+	bool redirected;             // a mispredict this clock; fetch resumes next clock
+	uint64_t redirectedAt;       // clock of the last mispredict, until the right path renames (0: none)
+	uint64_t unitFree[FU_COUNT]; // clock each multi-cycle unit accepts its next instruction
+
+	// stats
+	uint64_t committed;
+	uint64_t robOccupancy;       // summed every clock, for the average
+	uint64_t robFullStalls, rsFullStalls, serializeStalls;
+	uint64_t issuedOutOfOrder;   // issued while an older instruction was still waiting for operands
+	uint64_t operandWaitCycles;  // clocks RS entries spent waiting on a producer
+	uint64_t unitStalls;         // ready, but the multiplier or divider was inside its interval
+	uint64_t squashed;           // wrong-path instructions thrown away, ROB and fetch queue alike
+
+	int slot(int n) const { return (robHead + n) % (int)rob.size(); }
+	bool writes_register(const rob_entry &e) const;
+	bool older_store_pending(int idx) const;
+
+	void commit();
+	void complete();
+	void resolve();
+	void issue();
+	void rename();
+	void fetch();
+
+	void squash_after(int idx);
+	void read_operand(byte reg, int32_t *val, int *tag);
+};
+
+#endif /* _OOO_H_ */
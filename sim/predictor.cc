@@ -0,0 +1,27 @@
+#include "predictor.h"
+#include <stddef.h>
+
+twobit_predictor::twobit_predictor()
+{
+	for (int x = 0; x < 1024; x++) table[x] = 0;
+}
+
+
+twolevel_predictor::twolevel_predictor()
+{
+	for (int x = 0; x < 1024; x++) table[x] = 0;
+	history = 0;
+}
+
+
+predictor *make_predictor(int kind)
+{
+	switch (kind) {
+	case 0: return new not_taken_predictor();
+	case 1: return new taken_predictor();
+	case 2: return new twobit_predictor();
+	case 3: return new twolevel_predictor();
+	case 4: return new hint_predictor();
+	}
+	return NULL;
+}
@@ -0,0 +1,139 @@
+#include "profile.h"
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+typedef map<int, set<uint32_t> > owners_t;
+
+void branch_profile::record(uint32_t pc, bool taken, bool mispredict, int index)
+{
+	branch_record &r = records[pc];
+
+	r.pc = pc;
+	r.executed++;
+	if (taken) r.taken++;
+	if (mispredict) r.mispredicts++;
+	r.lastIndex = index;
+	if (index >= 0) r.indices.insert(index);
+}
+
+
+// Build the reverse map (table index -> static branches using it), which is how
+// aliasing in table2bit shows up.
+void branch_profile::index_owners(owners_t &owners) const
+{
+	for (records_t::const_iterator i = records.begin(); i != records.end(); ++i) {
+		const set<int> &idx = i->second.indices;
+		for (set<int>::const_iterator j = idx.begin(); j != idx.end(); ++j) {
+			owners[*j].insert(i->first);
+		}
+	}
+}
+
+
+uint32_t branch_profile::aliases(const branch_record &r, const owners_t &owners) const
+{
+	set<uint32_t> sharers;
+
+	for (set<int>::const_iterator j = r.indices.begin(); j != r.indices.end(); ++j) {
+		const set<uint32_t> &pcs = owners.find(*j)->second;
+		sharers.insert(pcs.begin(), pcs.end());
+	}
+	sharers.erase(r.pc);
+	return sharers.size();
+}
+
+
+static bool harder(const branch_record *a, const branch_record *b)
+{
+	if (a->mispredicts != b->mispredicts) return a->mispredicts > b->mispredicts;
+	return a->pc < b->pc;
+}
+
+
+void branch_profile::display(FILE *out, int top_n) const
+{
+	owners_t owners;
+	vector<const branch_record *> sorted;
+
+	index_owners(owners);
+	for (records_t::const_iterator i = records.begin(); i != records.end(); ++i) {
+		sorted.push_back(&i->second);
+	}
+	sort(sorted.begin(), sorted.end(), harder);
+	if (top_n >= 0 && (size_t)top_n < sorted.size()) sorted.resize(top_n);
+
+	fprintf(out, "-=-=-=-=-=-=Hardest-to-predict branches-=-=-=-=-=-=\n");
+	fprintf(out, "        pc      execs  taken%%  misses  miss%%  index  aliases\n");
+	for (size_t x = 0; x < sorted.size(); x++) {
+		const branch_record &r = *sorted[x];
+		fprintf(out, "0x%08x %10u  %5.1f  %6u  %5.1f  %5d  %7u\n"
+		       , r.pc, r.executed, 100.0 * r.taken_rate(), r.mispredicts
+		       , 100.0 * r.mispredict_rate(), r.lastIndex, aliases(r, owners));
+	}
+	fprintf(out, "-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=\n");
+}
+
+
+bool branch_profile::write_csv(const char *filename) const
+{
+	FILE *out = fopen(filename, "w");
+	if (!out) {
+		return false;
+	}
+
+	owners_t owners;
+	index_owners(owners);
+
+	fprintf(out, "pc,executed,taken,taken_rate,mispredicts,mispredict_rate,last_index,indices,aliases\n");
+	for (records_t::const_iterator i = records.begin(); i != records.end(); ++i) {
+		const branch_record &r = i->second;
+		fprintf(out, "0x%08x,%u,%u,%.4f,%u,%.4f,%d,%u,%u\n"
+		       , r.pc, r.executed, r.taken, r.taken_rate(), r.mispredicts
+		       , r.mispredict_rate(), r.lastIndex, (uint32_t)r.indices.size(), aliases(r, owners));
+	}
+	fclose(out);
+	return true;
+}
+
+
+void load_use_profile::record(uint32_t load_pc, uint32_t use_pc)
+{
+	load_record &r = records[load_pc];
+
+	r.stalls++;
+	r.users.insert(use_pc);
+}
+
+
+// most stalls first, then lowest pc
+static bool more_stalls(const pair<uint32_t, uint32_t> &a, const pair<uint32_t, uint32_t> &b)
+{
+	if (a.first != b.first) return a.first > b.first;
+	return a.second < b.second;
+}
+
+
+void load_use_profile::display(FILE *out, int top_n) const
+{
+	vector<pair<uint32_t, uint32_t> > sorted; // (stalls, pc)
+
+	for (records_t::const_iterator i = records.begin(); i != records.end(); ++i) {
+		sorted.push_back(make_pair(i->second.stalls, i->first));
+	}
+	sort(sorted.begin(), sorted.end(), more_stalls);
+	if (top_n >= 0 && (size_t)top_n < sorted.size()) sorted.resize(top_n);
+
+	fprintf(out, "-=-=-=-=-=-=-=-=-=Load-use stalls-=-=-=-=-=-=-=-=-=-=\n");
+	fprintf(out, "   load pc    stalls  waiting instructions\n");
+	for (size_t x = 0; x < sorted.size(); x++) {
+		const load_record &r = records.find(sorted[x].second)->second;
+		fprintf(out, "0x%08x %9u ", sorted[x].second, r.stalls);
+		for (set<uint32_t>::const_iterator j = r.users.begin(); j != r.users.end(); ++j) {
+			fprintf(out, " 0x%08x", *j);
+		}
+		fprintf(out, "\n");
+	}
+	fprintf(out, "-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=\n");
+}
@@ -0,0 +1,212 @@
+#include "server.h"
+#include "memory.h"
+#include "placement.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <map>
+
+using namespace std;
+
+static const char    *socketPath;
+static request_parser parseRequest;
+
+// An accepted client, and the host CPU its thread is pinned to (-1: not pinned).
+struct connection {
+	int fd;
+	int cpu;
+};
+
+// Memories of connections that have closed, by the NUMA node their pages were faulted in on.
+// They are kept mapped, with the pages the last job wrote still faulted in, so the next
+// connection does not start from a fresh 4 GiB mapping, and is handed one from its own node.
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static map<int, vector<memory *> > pool;
+
+
+static memory *take_memory(int node)
+{
+	memory *m = NULL;
+
+	pthread_mutex_lock(&poolLock);
+	vector<memory *> &spare = pool[node];
+	if (!spare.empty()) {
+		m = spare.back();
+		spare.pop_back();
+	}
+	pthread_mutex_unlock(&poolLock);
+	return m ? m : new memory;
+}
+
+
+static void give_memory(int node, memory *m)
+{
+	pthread_mutex_lock(&poolLock);
+	pool[node].push_back(m);
+	pthread_mutex_unlock(&poolLock);
+}
+
+
+// A JSON string: quotes, backslashes and control characters escaped.
+static void write_json_string(FILE *out, const char *s, size_t size)
+{
+	fputc('"', out);
+	for (size_t x = 0; x < size; x++) {
+		unsigned char c = s[x];
+		if (c == '"' || c == '\\') fprintf(out, "\\%c", c);
+		else if (c == '\n') fputs("\\n", out);
+		else if (c == '\t') fputs("\\t", out);
+		else if (c < 0x20) fprintf(out, "\\u%04x", c);
+		else fputc(c, out);
+	}
+	fputc('"', out);
+}
+
+
+// Runs one job on the connection's core and memory and writes its result.
+static void serve_job(core_context *core, memory *mem, const server_job &job, uint64_t id, const connection &c, FILE *out)
+{
+	FILE    *input = job.opts.inputFile ? fopen(job.opts.inputFile, "r") : NULL;
+	char    *output = NULL;
+	size_t   outputSize = 0;
+	FILE    *console = open_memstream(&output, &outputSize);
+	run_result r;
+	timespec begin, finish;
+
+	if (!input) input = fopen("/dev/null", "r");
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	mem->clear();
+	mem->load(text_segment, &(*job.text)[0], job.text->size());
+	if (job.data) mem->load(data_segment, &(*job.data)[0], job.data->size());
+	mem->collect_stats(true);
+	run_job(core, mem, job.opts, input, console, r);
+	memory_stats s = mem->stats();
+	mem->collect_stats(false);
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	fclose(console);
+	fclose(input);
+
+	fprintf(out, "{\"id\":%llu,\"status\":", (unsigned long long)id);
+	write_json_string(out, r.status, strlen(r.status));
+	fprintf(out, ",\"cycles\":%u,\"BPHits\":%u,\"BPMisses\":%u,\"branchFlushCycles\":%u", r.cycles, r.BPHits, r.BPMisses, r.branchFlushCycles);
+	fprintf(out, ",\"memReads\":%u,\"memWrites\":%u,\"bytesRead\":%u,\"bytesWritten\":%u,\"stackPushes\":%u,\"stackPops\":%u"
+	       , s.reads, s.writes, s.bytesRead, s.bytesWritten, s.pushes, s.pops);
+	if (c.cpu >= 0) fprintf(out, ",\"hostCpu\":%d,\"node\":%d", c.cpu, cpu_node(c.cpu));
+	fprintf(out, ",\"hostSeconds\":%.6f,\"output\":", (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9);
+	write_json_string(out, output, outputSize);
+	fputs("}\n", out);
+	free(output);
+}
+
+
+// One client. Its jobs run one after another, on a core and a memory it keeps until it hangs up.
+static void *serve_connection(void *arg)
+{
+	connection c = *(connection *)arg;
+	delete (connection *)arg;
+
+	// pinned before the core is made, so it is first touched, and allocated, on this node
+	if (c.cpu >= 0) pin_thread(c.cpu);
+	int   node = c.cpu >= 0 ? cpu_node(c.cpu) : -1;
+	FILE *in = fdopen(c.fd, "r");
+	FILE *out = fdopen(dup(c.fd), "w");
+	memory *mem = take_memory(node);
+	core_context *core = new_core_context();
+	char   *line = NULL;
+	size_t  capacity = 0;
+	ssize_t length;
+	uint64_t id = 0;
+
+	while ((length = getline(&line, &capacity, in)) >= 0) {
+		string request(line, length);
+		size_t first = request.find_first_not_of(" \t\r\n");
+		if (first == string::npos || request[first] == '#') {
+			continue;
+		}
+
+		server_job job;
+		string error;
+		id++;
+		if (parseRequest(request, job, error)) {
+			serve_job(core, mem, job, id, c, out);
+		}
+		else {
+			fprintf(out, "{\"id\":%llu,\"error\":", (unsigned long long)id);
+			write_json_string(out, error.c_str(), error.size());
+			fputs("}\n", out);
+		}
+		if (fflush(out) != 0) {
+			break;  // the client has gone
+		}
+	}
+	free(line);
+	delete_core_context(core);
+	give_memory(node, mem);
+	fclose(out);
+	fclose(in);
+	return NULL;
+}
+
+
+// SIGINT and SIGTERM take the socket with them.
+static void stop_server(int sig)
+{
+	unlink(socketPath);
+	_exit(0);
+}
+
+
+void run_server(const char *path, const vector<int> &cpus, request_parser parse)
+{
+	sockaddr_un addr;
+	int listener;
+	uint64_t accepted = 0;
+
+	socketPath = path;
+	parseRequest = parse;
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "%s: socket path too long\n", path);
+		exit(10);
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		perror("socket");
+		exit(20);
+	}
+	unlink(path);  // left behind by a server that was killed outright
+	if (bind(listener, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, SOMAXCONN) != 0) {
+		perror(path);
+		exit(20);
+	}
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, stop_server);
+	signal(SIGTERM, stop_server);
+
+	for (;;) {
+		int fd = accept(listener, NULL, NULL);
+		if (fd < 0) {
+			continue;
+		}
+		connection *c = new connection;
+		c->fd = fd;
+		c->cpu = cpus.empty() ? -1 : cpus[accepted++ % cpus.size()];
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, serve_connection, c) != 0) {
+			delete c;
+			close(fd);
+			continue;
+		}
+		pthread_detach(thread);
+	}
+}
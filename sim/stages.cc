@@ -1,5 +1,6 @@
 #include "cpu.h"
 #include "stages.h"
+#include "syscall.h"
 #include <assert.h>
 #include <stdio.h>
 #include <bitset>
@@ -12,53 +13,90 @@ static void inline decode_ops(uint16_t input, byte *dest, byte *src1, byte *src2
 	*src2 = (input & 0x7C00) >> 10;
 }
 
-static bool inline isBranch(IDl latch)
+static bool inline isBranch(const IDl &latch)
 {
 	return latch.control()->branch;
 }
 
+// The counter's direction, unless -H is on and the counter is only weakly biased (states 1
+// and 2); then a static hint from the assembler gets the final say.
+static bool applyHint(cpu_core *core, const IDl &latch, int state)
+{
+	bool guess = state > 1;
+
+	if (core->hintOverride && (state == 1 || state == 2) && latch.hint != HINT_NONE) {
+		bool hinted = latch.hint == HINT_TAKEN;
+		if (hinted != guess) core->hintOverrides++;
+		guess = hinted;
+	}
+	return guess;
+}
+
 /**
    The execute implementations. These actually perform the action of the stage.
  **/
 
-// Instructions are fetched from memory in this stage, and passed into the CPU's ID latch
-void InstructionFetchStage::Execute()
+// Cracks the 8-byte instruction at pc into latch. An unknown opcode faults here, so that no
+// later stage looks it up.
+void read_instruction(cpu_core *core, uint32_t pc, IDl &latch)
 {
-	if (OBF) {
-		return;
+	latch.PC = pc;
+	latch.opcode = core->mem->get<byte>(pc);
+	if (latch.opcode >= opcode_count) {
+		throw "Illegal instruction";
 	}
-	IBF=false;
-	
-	right.opcode = core->mem->get<byte>(core->PC);
-	uint16_t operands = core->mem->get<uint16_t>(core->PC + 1);
-	decode_ops(operands, &right.Rdest, &right.Rsrc1, &right.Rsrc2);
-	right.immediate = core->mem->get<uint32_t>(core->PC + 3);
+	uint16_t operands = core->mem->get<uint16_t>(pc + 1);
+	decode_ops(operands, &latch.Rdest, &latch.Rsrc1, &latch.Rsrc2);
+	latch.immediate = core->mem->get<uint32_t>(pc + 3);
+	latch.hint = core->mem->get<byte>(pc + 7);
+}
+
+
+// What the oracle BTB knows about the instruction at pc: the fields read_instruction cracks,
+// without counting memory reads, since nothing is fetched until Fetch reads it.
+static void predecode_instruction(cpu_core *core, uint32_t pc, IDl &latch)
+{
+	latch.PC = pc;
+	latch.opcode = core->mem->peek<byte>(pc);
+	if (latch.opcode >= opcode_count) {
+		throw "Illegal instruction";
+	}
+	decode_ops(core->mem->peek<uint16_t>(pc + 1), &latch.Rdest, &latch.Rsrc1, &latch.Rsrc2);
+	latch.immediate = core->mem->peek<uint32_t>(pc + 3);
+	latch.hint = core->mem->peek<byte>(pc + 7);
+}
 
+
+// Picks the next fetch address: the predictor's guess for a branch, the next instruction otherwise.
+// The prediction and what is needed to check it later are left in the latch.
+void predict_branch(cpu_core *core, IDl &latch)
+{
 	// <CAR_PA1_HOOK2> start
 	// !!! Assume an oracle BTB; i.e, we know if the current instruction is a branch or not and its target address.!!!
-	// !!! Taken branch target address is stored in "right.immediate"!!!	
+	// !!! Taken branch target address is stored in "latch.immediate"!!!	
 
 	switch(core->branchPredictor) { // Using switch for the branch predictor number
 	// 0 = Always not taken
 	// 1 = Always taken
 	// 2 = 2 Bit Predictor
 	// 3 = 2 Level Predictor (also known as 2 Bit history predictor)
+	// 4 = Static hints
 
  	case 0: // Always Not Taken
-		if (isBranch(right)) { 				// check if its a branch
-			right.predict_taken = false; 	// right.predict_taken is set to false
+		if (isBranch(latch)) { 				// check if its a branch
+			latch.predict_taken = false; 	// latch.predict_taken is set to false
 		} else {
-			right.predict_taken = false;
+			latch.predict_taken = false;
 		}
 		core->PC += 8; 						// Update program counter to move on
 		break;
 	case 1: // Always Taken
-		if (isBranch(right)) { 					// check if its a branch
-			right.predict_taken = true; 		// right.predict_taken set to true, because we are predicting it true for every case
-			right.recoveryPC = core->PC += 8; 	// store the program counter in a recovery program counter
-			core->PC= right.immediate;			// set the program counter to the branch target address
+		if (isBranch(latch)) { 					// check if its a branch
+			latch.predict_taken = true; 		// latch.predict_taken set to true, because we are predicting it true for every case
+			latch.recoveryPC = core->PC += 8; 	// store the program counter in a recovery program counter
+			core->PC= latch.immediate;			// set the program counter to the branch target address
 		} else {
-			right.predict_taken = false; 		// if its not a branch continue as usual
+			latch.predict_taken = false; 		// if its not a branch continue as usual
 			core->PC+=8; 						// update the program counter and move on
 		}
 		break;
@@ -66,88 +104,289 @@ void InstructionFetchStage::Execute()
 	case 2: // 2 bit predictor
 
 	int index2bit; 								// initialise an index as an integer that we'll use to access the table of states
-		if (isBranch(right)) { 					// check if its a branch
+		if (isBranch(latch)) { 					// check if its a branch
 			index2bit = ( core->PC >> 3 ) % 1024;//use the counter shifted by 3 to ignore least significant and mod 1024 to access states
-			right.state2bit = core->table2bit[index2bit];// save the state in a variable
-			right.address2bit = core->PC;
-			int state = right.state2bit; 		// save the state of the finite state machine of 2bit predictor in a variable
+			latch.state2bit = core->table2bit[index2bit];// save the state in a variable
+			latch.address2bit = core->PC;
+			int state = latch.state2bit; 		// save the state of the finite state machine of 2bit predictor in a variable
+			bool guess = applyHint(core, latch, state);
 
 			//WEAK NOT TAKEN AND STRONG NOT TAKEN
-			if (state<2) {						// State 0 = Strong not taken, State 1 = Weak not taken
-				right.predict_taken = false;	// Set predict to false i.e. not taken
+			if (!guess) {						// State 0 = Strong not taken, State 1 = Weak not taken
+				latch.predict_taken = false;	// Set predict to false i.e. not taken
 				core->PC += 8;					// Update program counter
 			}
 			//WEAK TAKEN AND STRONG TAKEN
-			if (state>1) {						// State 2 = Weak Taken, State 3 = Strong Taken
-				right.predict_taken = true;		// Predict taken
-				right.recoveryPC = core->PC += 8; // Store Program counter as a recovery program coutner
-				core->PC=right.immediate; 		// Set program counter the target branch address
+			if (guess) {						// State 2 = Weak Taken, State 3 = Strong Taken
+				latch.predict_taken = true;		// Predict taken
+				latch.recoveryPC = core->PC += 8; // Store Program counter as a recovery program coutner
+				core->PC=latch.immediate; 		// Set program counter the target branch address
 			}
 		}
 		else {
-			right.predict_taken=false;			// Again, if its not a branch continue as usual
+			latch.predict_taken=false;			// Again, if its not a branch continue as usual
 			core->PC+=8;						// Update program counter
 		}
 		break;
 
 	case 3: // 2 level history predictor
 
-		if (isBranch(right)) {								// Check if its a branch
+		if (isBranch(latch)) {								// Check if its a branch
 			int idx = (int)(core->index2level.to_ulong());	// Convert index which was a 10 bit binary representing last 10 branch outcomes
 
-			right.state2bit = core->table2bit[idx];  	// Access the table of states at that index converted ^
-			right.address2bit = core->PC;
-			right.index2level_c = core->index2level;	// copy index to a backup if in execute our prediction is wrong
+			latch.state2bit = core->table2bit[idx];  	// Access the table of states at that index converted ^
+			latch.address2bit = core->PC;
+			latch.index2level_c = core->index2level;	// copy index to a backup if in execute our prediction is wrong
 			std::bitset<10>hit = 0b0000000001;			// another 10 bitset with last bit as 1, to help change our index later on
 
-			int state = right.state2bit;				// state stored in variable again
+			int state = latch.state2bit;				// state stored in variable again
+			bool guess = applyHint(core, latch, state);
 
 			//WEAK NOT TAKEN AND STRONG NOT TAKEN
-			if (state<2) {								// State 0 = Strong not taken, State 1 = Weak not taken
-				right.predict_taken = false;			// Set Predict to false i.e. not predict
+			if (!guess) {								// State 0 = Strong not taken, State 1 = Weak not taken
+				latch.predict_taken = false;			// Set Predict to false i.e. not predict
 				core->index2level <<= 1;				// shift in by 1
 				core->PC += 8;							// Update program counter
 			}
 
 			//WEAK TAKEN AND STRONG TAKEN
-			if (state>1) {
-				right.predict_taken = true;				// State 2 = Weak Taken, State 3 = Strong Taken
-				right.recoveryPC = core->PC += 8;		// Store updated program counter in a recovery PC variable
+			if (guess) {
+				latch.predict_taken = true;				// State 2 = Weak Taken, State 3 = Strong Taken
+				latch.recoveryPC = core->PC += 8;		// Store updated program counter in a recovery PC variable
 				core->index2level <<= 1;  				// Shift in
 				core->index2level |= hit;				// Add 1 for the predicted taken
-				core->PC=right.immediate;				// Update PC to target branch address
+				core->PC=latch.immediate;				// Update PC to target branch address
 			}
 		}
 		else {
-			right.predict_taken=false;					// otherwise continue as usual
+			latch.predict_taken=false;					// otherwise continue as usual
+			core->PC+=8;
+		}
+		break;
+
+	case 4: // static hints from the assembler; unhinted branches are backward taken, forward not taken
+		if (isBranch(latch)) {
+			if (latch.hint == HINT_TAKEN || (latch.hint == HINT_NONE && latch.immediate <= core->PC)) {
+				latch.predict_taken = true;
+				latch.recoveryPC = core->PC += 8;
+				core->PC = latch.immediate;
+			} else {
+				latch.predict_taken = false;
+				core->PC += 8;
+			}
+		}
+		else {
+			latch.predict_taken=false;
 			core->PC+=8;
 		}
 		break;
 	// <CAR_PA1_HOOK2> end
 	}
+}
+
+
+// Instructions are fetched from memory in this stage, and passed into the CPU's ID latch
+void InstructionFetchStage::Execute()
+{
+	if (iqDepth) {
+		RunAhead();
+		return;
+	}
+	if (OBF) {
+		return;
+	}
+	IBF=false;
+	
+	Fetch(core->PC, right);
+	predict_branch(core, right);
+	TrackLoop(right);
+
 	OBF=true;
 }
 
+
+// Decode took the instruction in right along with the one before it (-f). The pair came
+// from one fetch block, so the next instruction is in right by the end of the same clock.
+void InstructionFetchStage::Refill()
+{
+	OBF=false;
+	if (!iqDepth) {
+		Execute();
+	}
+	else if (!iq.empty()) {
+		right = iq.front();
+		iq.pop_front();
+		OBF=true;
+	}
+}
+
+
+// Reads the instruction at pc, from the loop buffer when it holds it.
+void InstructionFetchStage::Fetch(uint32_t pc, IDl &latch)
+{
+	if (loopEntries && pc >= loopStart && pc <= loopEnd) {
+		int slot = (pc - loopStart) / 8;
+		if (loopValid[slot]) {
+			// the instruction only; with -Q the latch already carries its prediction
+			const IDl &i = loopBody[slot];
+			latch.PC = i.PC;
+			latch.opcode = i.opcode;
+			latch.Rdest = i.Rdest;
+			latch.Rsrc1 = i.Rsrc1;
+			latch.Rsrc2 = i.Rsrc2;
+			latch.immediate = i.immediate;
+			latch.hint = i.hint;
+			loopHits++;
+			return;
+		}
+		read_instruction(core, pc, latch);
+		loopBody[slot] = latch;
+		loopValid[slot] = true;
+	}
+	else {
+		read_instruction(core, pc, latch);
+	}
+	fetchAccesses++;
+}
+
+
+// A predicted-taken branch back to a target close enough for the whole body to fit marks a
+// new loop. Its body is captured as it is fetched again, and replayed after that. Only the
+// raw instruction is kept, so branches in the body are still predicted every time.
+void InstructionFetchStage::TrackLoop(const IDl &latch)
+{
+	if (!loopEntries || !latch.predict_taken || latch.immediate > latch.PC) {
+		return;
+	}
+	uint32_t size = (latch.PC - latch.immediate) / 8 + 1;
+	if (size > (uint32_t)loopEntries || (latch.immediate == loopStart && latch.PC == loopEnd)) {
+		return;
+	}
+	loopStart = latch.immediate;
+	loopEnd = latch.PC;
+	loopValid.assign(loopEntries, false);
+	loopsCaptured++;
+	if (core->verbose) printf("0x%08x loop buffer captures 0x%08x-0x%08x\n", (unsigned)latch.PC, (unsigned)loopStart, (unsigned)loopEnd);
+}
+
+
+void InstructionFetchStage::SetLoopBuffer(int entries)
+{
+	loopEntries = entries;
+	loopBody.resize(entries);
+	loopValid.assign(entries, false);
+}
+
+
+void InstructionFetchStage::SetQueues(int ftq_depth, int iq_depth)
+{
+	ftqDepth = ftq_depth;
+	iqDepth = iq_depth;
+	ftqHistogram.assign(ftq_depth + 1, 0);
+	iqHistogram.assign(iq_depth + 1, 0);
+}
+
+
+// The decoupled front end, one clock. With the oracle BTB the predictor knows which
+// instructions are branches without fetching them, so it can walk ahead of fetch: up to two
+// targets a clock, stopping after a predicted-taken branch. Fetch reads one target a clock
+// into the instruction queue, and decode sees the head of that queue in right. Everything
+// happens in the same clock when the queues are empty, so a redirect costs what it does
+// without the queues; the queues only absorb decode stalls.
+void InstructionFetchStage::RunAhead()
+{
+	for (int x = 0; x < 2 && (int)ftq.size() < ftqDepth; x++) {
+		IDl target;
+		predecode_instruction(core, core->PC, target);
+		predict_branch(core, target);
+		TrackLoop(target);
+		ftq.push_back(target);
+		if (target.predict_taken) break;
+	}
+	if (!ftq.empty() && (int)iq.size() < iqDepth) {
+		Fetch(ftq.front().PC, ftq.front());
+		iq.push_back(ftq.front());
+		ftq.pop_front();
+	}
+	if (!OBF && !iq.empty()) {
+		IBF=false;
+		right = iq.front();
+		iq.pop_front();
+		OBF=true;
+	}
+	ftqHistogram[ftq.size()]++;
+	iqHistogram[iq.size()]++;
+}
+
+
+void InstructionFetchStage::DisplayFetchStats()
+{
+	uint64_t clocks = 0;
+	for (size_t x = 0; x < iqHistogram.size(); x++) clocks += iqHistogram[x];
+
+	printf("stat.fetchAccesses: %llu\n", (unsigned long long)fetchAccesses);
+	if (loopEntries) {
+		printf("stat.loopBufferHits: %llu (%.1f%% of fetches, memory reads saved)\n", (unsigned long long)loopHits
+		      , (loopHits + fetchAccesses) ? 100.0 * loopHits / (loopHits + fetchAccesses) : 0.0);
+		printf("stat.loopsCaptured: %llu\n", (unsigned long long)loopsCaptured);
+	}
+	if (!iqDepth) {
+		return;
+	}
+	printf("stat.redirectDrops: %llu\n", (unsigned long long)redirectDrops);
+	for (size_t x = 0; x < ftqHistogram.size(); x++) {
+		printf("stat.ftqOccupancy[%d]: %llu (%.1f%%)\n", (int)x, (unsigned long long)ftqHistogram[x]
+		      , clocks ? 100.0 * ftqHistogram[x] / clocks : 0.0);
+	}
+	for (size_t x = 0; x < iqHistogram.size(); x++) {
+		printf("stat.iqOccupancy[%d]: %llu (%.1f%%)\n", (int)x, (unsigned long long)iqHistogram[x]
+		      , clocks ? 100.0 * iqHistogram[x] / clocks : 0.0);
+	}
+}
+
+// Operand for the decode stage's branch comparator (-e). The register file is good if
+// nothing in flight writes the register; otherwise only an ALU result that has reached
+// the memory stage can be forwarded. Anything younger (or a load) means a stall.
+bool InstructionDecodeStage::EarlyOperand(byte reg, int32_t *val)
+{
+	if (reg == 0 || core->registers[reg].lockRefCount == 0) {
+		*val = *(int32_t*) &core->registers[reg].value;
+		return true;
+	}
+	if (core->registers[reg].lockRefCount == 1 && core->mys.OBF &&
+	    core->mys.right.Rdest == reg && core->mys.right.control()->register_write &&
+	    !core->mys.right.control()->mem_read) {
+		*val = *(int32_t*) &core->mys.right.aluresult;
+		return true;
+	}
+	return false;
+}
+
+
 void InstructionDecodeStage::Execute()
 {
 	if (!IBF || OBF) {	//no input or output is not read by the next stage
 		return;
 	}
+
+	if (core->syscallsInFlight && (left.Rsrc1 == V_REG || left.Rsrc2 == V_REG)) {
+		// a syscall ahead of us may return a value in $v0, and nothing forwards it
+		return;
+	}
+
+	int32_t early1 = 0, early2 = 0;
+	bool early = core->earlyBranch && left.control()->branch;
+	if (early && !(EarlyOperand(left.Rsrc1, &early1) && EarlyOperand(left.Rsrc2, &early2))) {
+		// hold the branch (and so fetch) here until its operands can reach the comparator
+		core->earlyBranchStalls++;
+		return;
+	}
 	IBF=false;
 	
 	core->registers[0].value = 0; // wire register 0 to zero for all register reads
 	right.Rsrc1Val = *(int32_t*) &core->registers[left.Rsrc1].value;
 	right.Rsrc2Val = *(int32_t*) &core->registers[left.Rsrc2].value;
-	right.immediate = left.immediate;
-	right.Rsrc1 = left.Rsrc1;
-	right.Rsrc2 = left.Rsrc2;
-	right.Rdest = left.Rdest;
-	right.opcode = left.opcode;
-	right.predict_taken = left.predict_taken;
-	right.recoveryPC = left.recoveryPC;							// Carry over the recovery PC
-	right.state2bit = left.state2bit;							// Carry over the states of finite state machine for 2 bit predictor
-	right.address2bit = left.address2bit;						// Carry over address/index for 2 bit predictor
-	right.index2level_c = left.index2level_c;					// carry over index for 2level predictor
+	right.load(left);
 
 	if (right.Rsrc1 && core->registers[right.Rsrc1].lockRefCount) {
 		//printf("Rsrc1 (%d) is locked, stall ?\n", right.Rsrc1);
@@ -168,188 +407,85 @@ void InstructionDecodeStage::Execute()
 	if (right.Rdest && right.control()->register_write) {
 		core->registers[right.Rdest].lockRefCount++;
 	}
+	if (right.control()->special_case != NULL) {
+		core->syscallsInFlight++;
+	}
+
+	right.resolved = false;
+	TryFusion();
+	if (early) {
+		if (right.Rsrc1 && core->registers[right.Rsrc1].lockRefCount) core->earlyBranchForwards++;
+		if (right.Rsrc2 && core->registers[right.Rsrc2].lockRefCount) core->earlyBranchForwards++;
+		right.Rsrc1Val = early1;
+		right.Rsrc2Val = early2;
+		right.setRsrc1Ready(true);
+		right.setRsrc2Ready(true);
+		right.resolved = true;
+		// only the instruction behind us in fetch is on the wrong path
+		if (resolve_branch(core, right, branch_condition(right.opcode, early1, early2))) {
+			core->ifs.make_nop();
+			core->branchFlushCycles += 1;
+		}
+	}
 
 	OBF=true;
 }
 
 
-void ExecuteStage::Execute()
+// Macro-op fusion (-f): an addi/subi followed by a conditional branch on its result becomes
+// one op in right. It takes one slot through the pipeline and the branch resolves in
+// execute from the ALU result. The branch's other operand has to be readable now.
+void InstructionDecodeStage::TryFusion()
 {
-	if (!IBF || OBF) {	//no input or output is not read by the next stage
+	const IDl &b = core->ifs.right;
+
+	if (!core->fusion || (left.opcode != 1 && left.opcode != 8) || !left.Rdest || !core->ifs.OBF) {
 		return;
-	} else {
-		if (busyCycles==0)
-		{
-			// copy forward from previous latch
-			right.opcode = left.opcode;
-			right.Rsrc1 = left.Rsrc1;
-			right.Rsrc2 = left.Rsrc2;
-			right.Rsrc1Val = left.Rsrc1Val;
-			right.Rsrc2Val = left.Rsrc2Val;
-			right.Rdest = left.Rdest;	
-			//load execution cycles
-			busyCycles = left.control()->exe_cycles;
-		}
 	}
-	
-// execution stage start
-	--busyCycles;
-	if (busyCycles) {		//return if we need to wait for more cycles
-		//printf("Exe Stage Stall: Wait %d cycles\n",busyCycles);	
+	if (b.opcode < 2 || b.opcode > 4 || (core->syscallsInFlight && (b.Rsrc1 == V_REG || b.Rsrc2 == V_REG))) {
 		return;
-	} 
-	//set IBF to 0;
-	IBF=false;
-		
+	}
+	byte src2 = b.opcode == 2 ? 0 : b.Rsrc2; // beqz has no second operand
+	if (b.Rsrc1 != left.Rdest && src2 != left.Rdest) {
+		return;
+	}
+	if ((b.Rsrc1 != left.Rdest && core->registers[b.Rsrc1].lockRefCount) ||
+	    (src2 != left.Rdest && core->registers[src2].lockRefCount)) {
+		return;
+	}
+	right.fused = true;
+	right.fusedBranch = b;
+	right.fusedSrc1Val = *(int32_t*) &core->registers[b.Rsrc1].value;
+	right.fusedSrc2Val = *(int32_t*) &core->registers[src2].value;
+	if (core->verbose) printf("\033[34m*** FUSED\033[0m: '%s' at %08x with the branch at %08x\n", left.control()->name, left.PC, b.PC);
+	core->ifs.Refill();
+}
+
+
+// The ALU: second operand selection and the operation itself.
+uint32_t alu_result(const DEl &l)
+{
 	uint32_t param;
 	
-	switch (left.control()->alu_source) {
+	switch (l.control()->alu_source) {
 	case 0: // source from register
-		param = left.Rsrc2Val;
+		param = l.Rsrc2Val;
 		break;
 
 	case 1: // immediate add/sub
-		param = left.immediate;
+		param = l.immediate;
 		break;
 
 	case 2: // address calculation
-		param = left.immediate + *(uint32_t *)&left.Rsrc1Val;
+		param = l.immediate + *(uint32_t *)&l.Rsrc1Val;
 		break;
 	}
 	// for those operands which require signed arithmatic.
-	int32_t svalue = left.Rsrc1Val;
+	int32_t svalue = l.Rsrc1Val;
 	int32_t sparam = *(int32_t *)&param;
 	int32_t result = sparam;
 
-	if (left.control()->branch) {
-		bool taken = (left.opcode == 2 && left.Rsrc1Val == 0) ||
-		             (left.opcode == 3 && left.Rsrc1Val >= left.Rsrc2Val) ||
-		             (left.opcode == 4 && left.Rsrc1Val != left.Rsrc2Val);
-		// if mispredict, nop out IF and ID. (mispredict == prediction and taken differ)
-		if (core->verbose) printf(taken ? "taken %d  %d\n" : "nottaken %d  %d\n", left.Rsrc1Val, left.Rsrc2Val);
-		if (left.predict_taken != taken) {
-			if (core->verbose) printf("\033[32m*** MISPREDICT!\033[0m\n");
-			core->ifs.make_nop();
-			core->ids.make_nop();
-			core->BPMisses++;
-			// CASES FOR EXECUTION STAGE In the event a branch is mispredicted
-			switch(core->branchPredictor) {
-			case 0:
-				core->PC=left.immediate;
-				break;
-			case 1:
-				core->PC=left.recoveryPC;
-				break;
-			case 2: // 2 bit predictor
-
-				//STRONG NOT TAKEN - MISS
-				if (left.state2bit==0) {
-					core->PC=left.immediate;				// If strong not taken was mispredicted then branch was taken
-					core->table2bit[(left.address2bit >> 3) % 1024]+=1; // update the state of the finite state machine
-				}
-				//WEAK NOT TAKEN - MISS
-				if (left.state2bit==1) {
-					core->PC=left.immediate;				// if weak not taken was mis-predicted then branch was taken
-					core->table2bit[(left.address2bit >> 3) % 1024]+=1; // update the state of the finite state machine
-				}
-				//WEAK TAKEN - MISS
-				if (left.state2bit==2) {
-					core->PC=left.recoveryPC;				// if weak taken was mis predicted then branch was not taken
-					core->table2bit[(left.address2bit >> 3) % 1024]-=1; // update the state of the finite state machine
-				}
-				//STRONG TAKEN - MISS
-				if (left.state2bit==3) {
-					core->PC=left.recoveryPC;				// if strong taken was mis predicted then branch was taken
-					core->table2bit[(left.address2bit >> 3) % 1024]-=1; // update the state of the finite state machine
-				}
-
-				break;
-
-			case 3: // 2 level predictor
-				std::bitset<10>hit = 0b0000000001;   		// initialise a bitset to update global history buffer by 1
-				core->index2level = left.index2level_c; 	// copy index back as our prediction was wrong and we need to fix that
-				int idx = (int)(core->index2level.to_ulong()); // convert to int
-
-
-				//STRONG NOT TAKEN - MISS
-				if (left.state2bit==0) {
-					core->PC=left.immediate;				// set Program counter to target branch address
-					core->index2level <<= 1;				// shift in
-					core->index2level |= hit;				// if strong not taken was mispredicted then branch was taken
-															// update the state of the finite state machine
-					core->table2bit[idx]+=1;
-				}
-				//WEAK NOT TAKEN - MISS
-				if (left.state2bit==1) {
-					core->PC=left.immediate;				// set Program counter to target branch address
-					core->index2level <<= 1;				// shift in
-					core->index2level |= hit;				// if weak not taken was mispredicted then branch was taken
-															// update the state of the finite state machine
-					core->table2bit[idx]+=1;
-				}
-				//WEAK TAKEN - MISS
-				if (left.state2bit==2) {
-					core->PC=left.recoveryPC;				// set Program counter to recovery program counter
-					core->index2level <<= 1;				// shift in
-					core->table2bit[idx]-=1;				// update the state of the finite state machine
-				}
-				//STRONG TAKEN - MISS
-				if (left.state2bit==3) {
-					core->PC=left.recoveryPC;				// set Program counter to recovery program counter
-					core->index2level <<= 1;				// shift in
-					core->table2bit[idx]-=1; 				// update the state of the finite state machine
-				}
-				break;
-			}
-
-		} else {
-			// CASES FOR EXECUTION STAGE In the event a branch is predicted correctly.
-			core->BPHits++;
-			// 2bit predictor
-			if (core->branchPredictor==2) {
-
-				//STRONG NOT TAKEN
-				if (left.state2bit==0) {
-					core->table2bit[(left.address2bit >> 3) % 1024]+=0; // Finite state machine stays the same
-				}
-				//WEAK NOT TAKEN
-				if (left.state2bit==1) {
-					core->table2bit[(left.address2bit >> 3) % 1024]-=1; // Finite state machine goes from 1 to 0
-				}
-				//WEAK TAKEN
-				if (left.state2bit==2) {
-					core->table2bit[(left.address2bit >> 3) % 1024]+=1;	// Finite state machine goes from 2 to 3
-				}
-				//STRONG TAKEN
-				if (left.state2bit==3) {
-					core->table2bit[(left.address2bit >> 3) % 1024]+=0; // Finite state machine stays the same
-				}
-
-			}
-			//2level
-			if (core->branchPredictor==3) {
-				int idx = (int)(left.index2level_c.to_ulong());
-				//STRONG NOT TAKEN
-				if (left.state2bit==0) {
-					core->table2bit[idx]+=0;		// Finite state machine stays the same
-				}
-				//WEAK NOT TAKEN
-				if (left.state2bit==1) {
-					core->table2bit[idx]-=1;		// Finite state machine goes from 1 to 0
-				}
-				//WEAK TAKEN
-				if (left.state2bit==2) {
-					core->table2bit[idx]+=1;		// Finite state machine goes from 2 to 3
-				}
-				//STRONG TAKEN
-				if (left.state2bit==3) {
-					core->table2bit[idx]+=0;		// Finite state machine stays the same
-				}
-			}
-		}
-	}
-
-	switch (left.control()->alu_operation) {
+	switch (l.control()->alu_operation) {
 	case 0:
 		// do nothing, this operation does not require an alu op (copy forward)
 		break;
@@ -363,39 +499,145 @@ void ExecuteStage::Execute()
 		// do a signed subtract of param from reg1
 		result = svalue - sparam;
 		break;
+
+	case 3:
+		// signed multiply, low 32 bits
+		result = (int32_t)((int64_t)svalue * sparam);
+		break;
+
+	case 4:
+		// signed divide; like RISC-V, /0 gives -1 and the one overflowing case wraps, no trap
+		if (sparam == 0) result = -1;
+		else if (sparam == -1) result = (int32_t)(0u - (uint32_t)svalue);
+		else result = svalue / sparam;
+		break;
+
+	case 5:
+		// signed remainder; %0 gives the dividend
+		if (sparam == 0) result = svalue;
+		else if (sparam == -1) result = 0;
+		else result = svalue % sparam;
+		break;
 	}
-	right.aluresult = *(uint32_t *)&result;
-	OBF=true;	
+	return *(uint32_t *)&result;
 }
 
 
-void MemoryStage::Execute()
+void ExecuteStage::Execute()
 {
 	if (!IBF || OBF) {	//no input or output is not read by the next stage
 		return;
+	} else {
+		if (busyCycles==0)
+		{
+			// copy forward from previous latch
+			right.opcode = left.opcode;
+			right.Rsrc1 = left.Rsrc1;
+			right.Rsrc2 = left.Rsrc2;
+			right.Rsrc1Val = left.Rsrc1Val;
+			right.Rsrc2Val = left.Rsrc2Val;
+			right.Rdest = left.Rdest;	
+			right.PC = left.PC;
+			//load execution cycles
+			busyCycles = left.control()->exe_cycles;
+		}
+	}
+	
+// execution stage start
+	--busyCycles;
+	if (busyCycles) {		//return if we need to wait for more cycles
+		//printf("Exe Stage Stall: Wait %d cycles\n",busyCycles);	
+		return;
+	} 
+	//set IBF to 0;
+	IBF=false;
+		
+	if (left.control()->branch && !left.resolved) {
+		bool taken = branch_condition(left.opcode, left.Rsrc1Val, left.Rsrc2Val);
+		// if mispredict, nop out IF and ID. (mispredict == prediction and taken differ)
+		if (resolve_branch(core, left, taken)) {
+			core->ifs.make_nop();
+			core->ids.make_nop();
+			core->branchFlushCycles += 2;
+		}
 	}
-	IBF=false;	
 
-	const instruction *control = left.control();
+	right.aluresult = alu_result(left);
+	if (left.fused) {
+		DEl branch;
+		branch.load(left.fusedBranch);
+		branch.Rsrc1Val = branch.Rsrc1 == left.Rdest ? *(int32_t*) &right.aluresult : left.fusedSrc1Val;
+		branch.Rsrc2Val = branch.Rsrc2 == left.Rdest ? *(int32_t*) &right.aluresult : left.fusedSrc2Val;
+		if (branch.opcode == 2) branch.Rsrc2Val = 0;
+		core->fusedPairs++; // counted here, where the wrong path can no longer reach
+		if (resolve_branch(core, branch, branch_condition(branch.opcode, branch.Rsrc1Val, branch.Rsrc2Val))) {
+			core->ifs.make_nop();
+			core->ids.make_nop();
+			core->branchFlushCycles += 2;
+		}
+	}
+	OBF=true;	
+}
 
-	right.aluresult = left.aluresult;
-	right.mem_data = 0;
+
+// Performs the load or store of an instruction at addr. Returns the loaded data (0 if none).
+uint32_t memory_access(cpu_core *core, const instruction *control, uint32_t addr, int32_t store)
+{
+	uint32_t data = 0;
+
+	if (core->caches && (control->mem_read || control->mem_write)) {
+		core->caches->wait_turn(core->coreId, core->cycles);
+	}
 	if (control->mem_read) {
 		if (control->mem_read == 1) {
-			right.mem_data = core->mem->get<byte>(left.aluresult);
+			data = core->mem->get<byte>(addr);
 		}
 		else if (control->mem_read == 4) {
-			right.mem_data = core->mem->get<uint32_t>(left.aluresult);
+			data = core->mem->get<uint32_t>(addr);
 		}
 	}
 	else if (control->mem_write) {
 		if (control->mem_write == 1) {
-			core->mem->set<byte>(left.aluresult, left.Rsrc2Val);
+			core->mem->set<byte>(addr, store);
 		}
 		else if (control->mem_write == 4) {
-			core->mem->set<uint32_t>(left.aluresult, left.Rsrc2Val);
+			core->mem->set<uint32_t>(addr, store);
 		}
 	}
+	return data;
+}
+
+
+// Clocks the L1 data cache adds to that access (0 without caches).
+int cache_access(cpu_core *core, const instruction *control, uint32_t addr)
+{
+	if (!core->caches || !(control->mem_read || control->mem_write)) {
+		return 0;
+	}
+	int size = control->mem_read ? control->mem_read : control->mem_write;
+	core->caches->wait_turn(core->coreId, core->cycles);
+	return core->caches->access(core->coreId, addr, size, control->mem_write != 0);
+}
+
+
+void MemoryStage::Execute()
+{
+	if (!IBF || OBF) {	//no input or output is not read by the next stage
+		return;
+	}
+	if (busyCycles == 0) {
+		busyCycles = 1 + cache_access(core, left.control(), left.aluresult);
+	}
+	if (--busyCycles) {
+		// waiting on the L1; everything behind holds
+		return;
+	}
+	IBF=false;	
+
+	const instruction *control = left.control();
+
+	right.aluresult = left.aluresult;
+	right.mem_data = memory_access(core, control, left.aluresult, left.Rsrc2Val);
 
 	right.opcode = left.opcode;
 	right.Rsrc1Val = left.Rsrc1Val;
@@ -416,6 +658,7 @@ void WriteBackStage::Execute()
 
 	if (control->special_case != NULL) {
 		control->special_case(core);
+		core->syscallsInFlight--;
 	}
 	if (control->register_write) {
 		if (control->mem_to_register) {
@@ -461,6 +704,15 @@ void ExecuteStage::Shift()
 		left = core->ids.right;
 		core->ids.OBF=false;
 	} else {
+		// A decoded instruction still waiting here has a load ahead of it: loaded data is
+		// forwarded from the memory stage, so the load has just moved there and this is the bubble.
+		const EMl &load = core->mys.left;
+		if (core->ids.OBF && load.control()->mem_read && load.Rdest &&
+		    (load.Rdest == core->ids.right.Rsrc1 || load.Rdest == core->ids.right.Rsrc2)) {
+			core->loadUseStalls++;
+			if (core->loadUse) core->loadUse->record(load.PC, core->ids.right.PC);
+			if (core->verbose) printf("\033[34m*** LOAD-USE\033[0m: bubble behind lb at %08x\n", load.PC);
+		}
 		//create a nop if the previous stage is not ready
 		left.reset();
 	}
@@ -528,6 +780,9 @@ void ExecuteStage::DoForwarding()
 
 void MemoryStage::DoForwarding()
 {
+	if (busyCycles > 0)
+		return; // right still holds the instruction before the one waiting on the L1
+
 	// If the next to previous instruction (IDS) is attempting a READ of the same register the instruction
 	// in this stage is supposed to WRITE, then here, update the next-to-previous stage's right latch
 	// with the value coming out of the this stage. (also, the read is not on zero)
@@ -559,6 +814,9 @@ void InstructionDecodeStage::make_nop()
 		core->registers[right.Rdest].lockRefCount--;
 		//printf("Lock dest register:R%d ref:%d",right.Rdest,core->registers[right.Rdest].lockRefCount)
 	}
+	if (OBF && right.control()->special_case != NULL) {
+		core->syscallsInFlight--;
+	}
 
 	left.reset();
 	right.reset();
@@ -566,3 +824,63 @@ void InstructionDecodeStage::make_nop()
 	right.setRsrc2Ready(true);
 }
 
+
+// Branch resolution, shared by the execute stage and (with -e) the decode stage.
+bool resolve_branch(cpu_core *core, const DEl &branch, bool taken)
+{
+	bool mispredict = branch.predict_taken != taken;
+
+	if (core->verbose) printf(taken ? "taken %d  %d\n" : "nottaken %d  %d\n", branch.Rsrc1Val, branch.Rsrc2Val);
+	if (core->profile) {
+		int index = -1; // the table2bit entry the prediction came from
+		if (core->branchPredictor == 2) index = (branch.address2bit >> 3) % 1024;
+		if (core->branchPredictor == 3) index = (int)branch.index2level_c.to_ulong();
+		core->profile->record(branch.PC, taken, mispredict, index);
+	}
+	if (core->trace) core->trace->record(branch.PC, branch.immediate, taken, branch.hint);
+	// shadow predictors see the branch at resolution, so they predict with an up-to-date history
+	for (size_t x = 0; x < core->shadows.size(); x++) {
+		shadow_predictor &sp = core->shadows[x];
+		if (sp.model->predict(branch.PC, branch.immediate, branch.hint) == taken) sp.BPHits++;
+		else sp.BPMisses++;
+		sp.model->update(branch.PC, branch.immediate, taken);
+	}
+	if (mispredict) {
+		if (core->verbose) printf("\033[32m*** MISPREDICT!\033[0m\n");
+		core->BPMisses++;
+		// CASES FOR BRANCH RESOLUTION In the event a branch is mispredicted
+		switch(core->branchPredictor) {
+		case 0:
+			core->PC=branch.immediate;
+			break;
+		case 1:
+			core->PC=branch.recoveryPC;
+			break;
+		case 2: // 2 bit predictor
+		case 4: // static hints
+			// a hint may have overruled the counter, so recover from what was predicted, not from the state
+			core->PC = branch.predict_taken ? branch.recoveryPC : branch.immediate;
+			break;
+
+		case 3: // 2 level predictor
+			core->PC = branch.predict_taken ? branch.recoveryPC : branch.immediate;
+			core->index2level = branch.index2level_c; 	// copy index back as our prediction was wrong and we need to fix that
+			core->index2level <<= 1;					// shift in the real outcome
+			if (taken) core->index2level |= std::bitset<10>(1);
+			break;
+		}
+
+	} else {
+		// CASES FOR BRANCH RESOLUTION In the event a branch is predicted correctly.
+		core->BPHits++;
+	}
+
+	// train the finite state machine the prediction came from on the real outcome
+	if (core->branchPredictor==2) {
+		train_2bit(core->table2bit[(branch.address2bit >> 3) % 1024], taken);
+	}
+	if (core->branchPredictor==3) {
+		train_2bit(core->table2bit[branch.index2level_c.to_ulong()], taken);
+	}
+	return mispredict;
+}
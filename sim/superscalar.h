@@ -0,0 +1,114 @@
+#ifndef _SUPERSCALAR_H_
+#define _SUPERSCALAR_H_
+#include <vector>
+#include "cpu.h"
+
+// One instruction in flight through the superscalar pipeline.
+struct uop {
+	DEl      d;           // decoded fields, operand values and the prediction, as in the ID/EX latch
+	uint32_t aluresult;
+	uint32_t mem_data;
+	uint64_t seq;         // program order
+	uint64_t doneCycle;   // clock the functional unit hands the result on
+	uint64_t memDone;     // clock it leaves the last memory sub-stage
+	int      thread;
+};
+
+// An instruction working its way through the fetch sub-stages.
+struct fetch_slot {
+	IDl      l;
+	uint64_t ready;       // clock it reaches decode
+};
+
+// One hardware thread. The architectural part is swapped into cpu_core while the pipeline
+// works on the thread, so the stage hooks and syscalls see only that thread's state.
+struct hw_thread {
+	uint32_t PC;
+	RegisterStruct registers[32];
+	memory  *mem;
+	bool     running;
+
+	std::vector<fetch_slot> fetched;
+	std::vector<uop> decoded;
+	bool     serializing;  // a syscall is in flight; nothing younger issues until it retires
+	uint64_t fetchResume;  // after a mispredict, the clock fetch starts on the right path
+	uint64_t redirectedAt; // clock of the last mispredict, until the right path issues (0: none)
+
+	// bypass network: the youngest in-flight value for each register and when it can be read
+	uint32_t fwdValue[32];
+	uint64_t fwdReady[32];
+	uint64_t fwdSeq[32];
+
+	uint64_t retired;
+	uint64_t fetchClocks;  // clocks the fetch policy gave this thread
+	uint64_t finishCycle;
+};
+
+// An in-order pipeline that fetches, decodes, issues and retires up to width instructions per
+// clock. It uses the same cpu_core state as the five stage pipeline: registers and their
+// lockRefCount scoreboard, the branch predictor (through predict_branch/resolve_branch), and
+// the stats. Each group of stages is a latch holding up to width uops; a clock moves them
+// back to front, so a latch only fills once the one after it has drained.
+//
+// With depth k, fetch, execute and memory are each split into k sub-stages, so the pipeline
+// is 3k + 2 stages long. Every latency is counted in the shorter clock: fetch takes k clocks,
+// an ALU result k and a load k more, and a branch only redirects fetch once it has gone
+// through all of execute.
+//
+// With two threads (SMT), fetch picks one thread a clock by the fetch policy, each thread
+// decodes into its own latch, and issue fills the shared width from both, taking turns at
+// going first. The functional units, ports, predictor tables and stats are shared.
+class superscalar_pipeline {
+public:
+	superscalar_pipeline(cpu_core *c, const cpu_options &opts);
+
+	void cycle();
+	void display_stats();
+
+private:
+	cpu_core *core;
+	int width;
+	int aluPorts, memPorts;
+	bool scoreboard;       // out-of-order completion, CDC 6600 style
+	int wbPorts;           // results written back per clock with scoreboard
+	int depth;             // sub-stages per fetch, execute and memory stage
+
+	std::vector<hw_thread> threads;
+	int current;           // thread whose state is in core
+	int fetchPolicy;
+	int lastFetched, issueFirst;
+
+	std::vector<uop> executing, memacc, retiring;
+	uint64_t nextSeq;
+	uint64_t unitFree[FU_COUNT]; // clock each multi-cycle unit accepts its next instruction
+
+	// stats
+	uint64_t retired;
+	std::vector<uint64_t> issueHistogram;  // clocks that issued 0..width uops
+	uint64_t dependencyStalls;             // operand produced by an older group, not ready yet
+	uint64_t groupStalls;                  // operand produced earlier in the same issue group
+	uint64_t portStalls;                   // out of ALU or memory ports
+	uint64_t unitStalls;                   // multiplier or divider still inside its initiation interval
+	uint64_t completionStalls;             // would finish ahead of an older multi-cycle instruction
+	uint64_t wawStalls;                    // scoreboard: destination still has a write in flight
+	uint64_t writebackConflicts;           // scoreboard: finished, but lost writeback arbitration
+	uint64_t redirects, redirectClocks;    // mispredicts, and the clocks from each to the right path's first issue
+
+	void writeback();
+	void memory_stage();
+	void execute();
+	void enter_memory(const uop &u);
+	void issue();
+	int  issue_thread(int t, int room, int &aluUsed, int &memUsed);
+	void decode();
+	void fetch();
+	int  pick_fetch_thread();
+
+	void use_thread(int t);
+	bool operand(hw_thread &th, byte reg, int32_t *val, bool *same_group, uint64_t group_start);
+	bool write_lands_after(int t, byte reg, uint64_t done);
+	bool in_flight(int t);
+	void squash_front_end(int t);
+};
+
+#endif /* _SUPERSCALAR_H_ */
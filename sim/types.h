@@ -4,6 +4,11 @@
 
 typedef uint8_t byte;
 
+// Static branch hints, carried by the assembler in the padding byte (offset 7) of an instruction.
+const byte HINT_NONE = 0;
+const byte HINT_TAKEN = 1;
+const byte HINT_NOT_TAKEN = 2;
+
 struct system_string {
 	int32_t len;
 	char *ptr;